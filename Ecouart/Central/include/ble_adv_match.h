@@ -0,0 +1,55 @@
+/**
+ * @file ble_adv_match.h
+ * @brief Interface de verificação dos dados de advertising. Não depende do
+ * Zephyr para poder ser compilada e testada no host.
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef BLE_ADV_MATCH_H_
+#define BLE_ADV_MATCH_H_
+
+#include "stddef.h"
+#include "stdint.h"
+
+/**
+ * @brief Tipo AD de lista incompleta de UUIDs de 16 bits.
+ *
+ */
+#define BLE_ADV_TYPE_UUID16_SOME 0x02
+
+/**
+ * @brief Tipo AD de lista completa de UUIDs de 16 bits.
+ *
+ */
+#define BLE_ADV_TYPE_UUID16_ALL 0x03
+
+/**
+ * @brief Resultado da verificação dos dados de advertising.
+ *
+ */
+enum ble_adv_match_result {
+  BLE_ADV_NO_MATCH = 0,   /* UUID não anunciado. */
+  BLE_ADV_MATCH = 1,      /* UUID anunciado em uma lista de UUID16. */
+  BLE_ADV_MALFORMED = -1, /* UUID não anunciado e há estrutura malformada. */
+};
+
+/**
+ * @brief Verifica se os dados de advertising anunciam um UUID de 16 bits.
+ *
+ * Percorre as estruturas AD com as mesmas regras de bt_data_parse: para no
+ * primeiro tamanho zero ou em uma estrutura que ultrapassa o buffer. Listas
+ * de UUID16 com tamanho ímpar são ignoradas e a varredura continua.
+ *
+ * @param data [in] Ponteiro para os dados de advertising.
+ * @param len Tamanho dos dados de advertising.
+ * @param uuid UUID de 16 bits procurado.
+ * @return enum ble_adv_match_result Resultado da verificação.
+ */
+enum ble_adv_match_result ble_adv_match_uuid16(const uint8_t *data,
+                                               size_t len, uint16_t uuid);
+
+#endif /* BLE_ADV_MATCH_H_ */
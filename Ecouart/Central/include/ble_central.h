@@ -20,9 +20,30 @@
 #include <sys/printk.h>
 #include <zephyr.h>
 
+#include "ble_adv_match.h"
+#include "ecouart_boot.h"
+#include "ecouart_bridge.h"
+#include "ecouart_trace.h"
+#include "journal_client.h"
+#include "notify_fanout.h"
+#include "outbound_qos.h"
+#include "perf_params.h"
+#include "scan_sched.h"
 #include "stdint.h"
 #include "stdlib.h"
 #include "string.h"
+#include "time_sync.h"
+#include "traffic_capture.h"
+
+/**
+ * @brief Imprime cada relatório de advertising recebido. Desligado por
+ * padrão: com muitos anunciantes o printk de cada relatório limita a vazão
+ * do escaneamento à velocidade da UART.
+ *
+ */
+#ifndef BLE_CENTRAL_LOG_ADV_REPORTS
+#define BLE_CENTRAL_LOG_ADV_REPORTS 0
+#endif
 
 /**
  * @brief Valor do UUID do serviço BLE UART.
@@ -63,7 +84,35 @@
   BT_UUID_DECLARE_16(BLE_UART_WRITE_CHAR_UUID_VAL)
 
 /**
- * @brief Escreve na característica BLE UART WRITE.
+ * @brief Valor do UUID da característica do diário de mensagens do
+ * Peripheral.
+ *
+ */
+#define BLE_UART_JOURNAL_CHAR_UUID_VAL 0x2BC7
+
+/**
+ * @brief UUID da característica do diário de mensagens do Peripheral.
+ *
+ */
+#define BLE_UART_JOURNAL_CHAR_UUID                                             \
+  BT_UUID_DECLARE_16(BLE_UART_JOURNAL_CHAR_UUID_VAL)
+
+/**
+ * @brief Valor do UUID da característica de sincronização de relógio.
+ *
+ */
+#define BLE_UART_SYNC_CHAR_UUID_VAL 0x2BC8
+
+/**
+ * @brief UUID da característica de sincronização de relógio.
+ *
+ */
+#define BLE_UART_SYNC_CHAR_UUID                                                \
+  BT_UUID_DECLARE_16(BLE_UART_SYNC_CHAR_UUID_VAL)
+
+/**
+ * @brief Enfileira uma mensagem na lane de controle de outbound_qos, à
+ * frente de qualquer transferência em massa.
  *
  * @param buf [in] Ponteiro para buffer que contém dados a serem transmitidos.
  * @param buf_len Tamanho do buffer que contém dados a serem transmitidos.
@@ -71,6 +120,60 @@
  */
 int ble_central_write_input(uint8_t *buf, uint16_t buf_len);
 
+/**
+ * @brief Escreve um único bloco na característica BLE UART WRITE, sem
+ * resposta. Usado pelo escalonador de outbound_qos.
+ *
+ * @param buf [in] Ponteiro para o bloco.
+ * @param len Tamanho do bloco, até ble_central_max_payload().
+ * @param func Callback chamado quando o bloco deixa a stack Bluetooth.
+ * @param user_data Argumento repassado ao callback.
+ * @return int 0 para sucesso e um inteiro negativo em caso de falha.
+ */
+int ble_central_write_chunk(const uint8_t *buf, uint16_t len,
+                            bt_gatt_complete_func_t func, void *user_data);
+
+/**
+ * @brief Maior bloco que cabe em uma escrita com a MTU atual.
+ *
+ * @return uint16_t Tamanho em bytes (MTU - 3).
+ */
+uint16_t ble_central_max_payload(void);
+
+/**
+ * @brief Interrompe o escaneamento em andamento e, se houver parâmetros,
+ * reinicia com eles. Usada pelo escalonador de escaneamento.
+ *
+ * @param param [in] Parâmetros do novo escaneamento, ou NULL para parar.
+ * @return int 0 para sucesso e um inteiro negativo em caso de falha.
+ */
+int ble_central_scan(const struct bt_le_scan_param *param);
+
+/**
+ * @brief Pede ao Peripheral conectado, se houver, os parâmetros de conexão
+ * atuais de perf_params.
+ *
+ */
+void ble_central_update_conn_params(void);
+
+/**
+ * @brief Obtém uma referência à conexão ativa, para uso fora da thread do
+ * Bluetooth.
+ *
+ * @return struct bt_conn* Conexão com referência própria, liberada com
+ * bt_conn_unref, ou NULL sem conexão.
+ */
+struct bt_conn *ble_central_get_conn(void);
+
+/**
+ * @brief Indica se há um Peripheral conectado, com a característica de escrita
+ * descoberta e o notify inscrito.
+ *
+ * @return true Se o caminho de dados está pronto.
+ * @return false Caso contrário.
+ */
+bool ble_central_is_ready(void);
+
 /**
  * @brief Inicializa a stack bluetooth com lógica BLE UART Central.
  *
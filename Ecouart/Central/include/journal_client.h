@@ -0,0 +1,65 @@
+/**
+ * @file journal_client.h
+ * @brief Interface do cliente do diário de mensagens do Peripheral. Guarda a
+ * próxima sequência esperada entre conexões e, a cada reconexão, pede ao
+ * Peripheral tudo o que foi registrado desde então. O Peripheral avança o
+ * pedido além do que este Central escreveu na sessão anterior, que ele já
+ * recebeu ao vivo, e informa o ponto de partida no registro vazio inicial.
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef JOURNAL_CLIENT_H_
+#define JOURNAL_CLIENT_H_
+
+#include <sys/byteorder.h>
+#include <sys/printk.h>
+#include <zephyr.h>
+
+#include "stdint.h"
+#include "string.h"
+
+/**
+ * @brief Cabeçalho de um registro: sequência (u32 LE) e tamanho (u8).
+ *
+ */
+#define JOURNAL_CLIENT_RECORD_HDR 5
+
+/**
+ * @brief Contadores do último download.
+ *
+ */
+struct journal_client_stats {
+  uint32_t records; /* Registros recebidos. */
+  uint32_t bytes;   /* Bytes de notificação recebidos. */
+  uint32_t gaps;    /* Sequências puladas (sobrescritas no Peripheral). */
+  int64_t start_ms; /* Uptime do pedido. */
+  int64_t end_ms;   /* Uptime do registro final. */
+};
+
+/**
+ * @brief Monta o pedido de download a partir da próxima sequência esperada.
+ *
+ * @param request [out] Buffer de 4 bytes que recebe o pedido.
+ */
+void journal_client_build_request(uint8_t request[4]);
+
+/**
+ * @brief Trata uma notificação de download.
+ *
+ * @param data [in] Ponteiro para os registros empacotados.
+ * @param len Tamanho dos registros empacotados.
+ */
+void journal_client_on_notify(const uint8_t *data, uint16_t len);
+
+/**
+ * @brief Copia os contadores do último download.
+ *
+ * @param stats [out] Ponteiro para estrutura que recebe os contadores.
+ */
+void journal_client_get_stats(struct journal_client_stats *stats);
+
+#endif /* JOURNAL_CLIENT_H_ */
@@ -16,5 +16,56 @@
 #include <zephyr.h>
 
 #include "ble_central.h"
+#include "perf_params.h"
+
+/**
+ * @brief Quantidade de linhas geradas quando não há console (build nativo).
+ *
+ */
+#define MESSAGE_RECEPTOR_SIM_MESSAGES 100
+
+/**
+ * @brief Tamanho máximo das linhas geradas quando não há console.
+ *
+ */
+#define MESSAGE_RECEPTOR_SIM_LINE_MAX 32
+
+/**
+ * @brief Espera padrão da tarefa de entrada entre linhas, em milissegundos.
+ *
+ */
+#define MESSAGE_RECEPTOR_SLEEP_MS 100
+
+/**
+ * @brief Prioridade padrão da tarefa de entrada.
+ *
+ */
+#define MESSAGE_RECEPTOR_PRIO 1
+
+/**
+ * @brief Pilha padrão da tarefa de entrada, em bytes.
+ *
+ */
+#define MESSAGE_RECEPTOR_STACK_SIZE 1024
+
+/**
+ * @brief Pilha reservada para a tarefa de entrada; limita o ajuste de
+ * PERF_INPUT_STACK. A reserva não muda com o ajuste, que só serve para achar
+ * a menor pilha que a tarefa aguenta antes de reduzir este valor.
+ *
+ */
+#define MESSAGE_RECEPTOR_STACK_MAX 2048
+
+/**
+ * @brief Cria a tarefa de entrada com a pilha e a prioridade de perf_params.
+ *
+ */
+void message_receptor_init(void);
+
+/**
+ * @brief Aplica à tarefa de entrada a prioridade atual de perf_params.
+ *
+ */
+void message_receptor_update_priority(void);
 
 #endif /* MESSAGE_RECEPTOR_H_ */
\ No newline at end of file
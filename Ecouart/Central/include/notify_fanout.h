@@ -0,0 +1,182 @@
+/**
+ * @file notify_fanout.h
+ * @brief Interface de distribuição das notificações recebidas pelo Central.
+ * Cada payload é copiado uma única vez para um net_buf com contagem de
+ * referências, compartilhado por todos os assinantes. Cada assinante tem sua
+ * própria fila e thread, de forma que um consumidor lento só perde as suas
+ * mensagens e não atrasa o callback de RX do Bluetooth. Para que um
+ * assinante lento não esgote o pool e cause perdas nos demais, cada fila é
+ * limitada a uma cota do pool (ver NOTIFY_FANOUT_BUF_COUNT).
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef NOTIFY_FANOUT_H_
+#define NOTIFY_FANOUT_H_
+
+#include <net/buf.h>
+#include <sys/atomic.h>
+#include <sys/printk.h>
+#include <zephyr.h>
+
+#include "stdint.h"
+
+/**
+ * @brief Quantidade de buffers compartilhados entre as filas dos assinantes.
+ * Com n assinantes, cada fila guarda no máximo (COUNT - 1) / n - 1
+ * mensagens; somado ao buffer em uso por cada handler, sobra sempre um
+ * buffer livre para a próxima publicação, e a política de fila cheia de
+ * cada assinante atua antes de o pool se esgotar.
+ *
+ */
+#define NOTIFY_FANOUT_BUF_COUNT 32
+
+/**
+ * @brief Maior payload de notificação (MTU de 247 menos o cabeçalho ATT).
+ *
+ */
+#define NOTIFY_FANOUT_BUF_SIZE 244
+
+/**
+ * @brief Quantidade máxima de assinantes.
+ *
+ */
+#define NOTIFY_FANOUT_MAX_SUBS 8
+
+/**
+ * @brief Tamanho da pilha da thread de cada assinante.
+ *
+ */
+#define NOTIFY_FANOUT_STACK_SIZE 1024
+
+/**
+ * @brief Maior profundidade de fila aplicável em tempo de execução; cada
+ * assinante fica ainda limitado à capacidade da própria fila.
+ *
+ */
+#define NOTIFY_FANOUT_MAX_DEPTH 16
+
+/**
+ * @brief Política aplicada quando a fila de um assinante está cheia.
+ *
+ */
+enum notify_fanout_policy {
+  NOTIFY_FANOUT_DROP_NEWEST, /* Descarta a mensagem que está chegando. */
+  NOTIFY_FANOUT_DROP_OLDEST, /* Descarta a mais antiga da fila. */
+};
+
+/**
+ * @brief Contadores de um assinante.
+ *
+ */
+struct notify_fanout_sub_stats {
+  uint32_t delivered;  /* Mensagens entregues ao handler. */
+  uint32_t dropped;    /* Mensagens descartadas por fila cheia. */
+  uint32_t high_water; /* Maior ocupação observada da fila. */
+  uint32_t lat_max_us; /* Maior atraso entre publicação e entrega. */
+  uint64_t lat_sum_us; /* Soma dos atrasos, para a média. */
+};
+
+struct notify_fanout_sub;
+
+/**
+ * @brief Handler de um assinante, chamado na thread do assinante.
+ *
+ * @param sub [in] Ponteiro para o assinante.
+ * @param buf [in] Buffer compartilhado com o payload; somente leitura. A
+ * referência é liberada após o retorno, use net_buf_ref para retê-lo.
+ */
+typedef void (*notify_fanout_handler_t)(struct notify_fanout_sub *sub,
+                                        struct net_buf *buf);
+
+/**
+ * @brief Assinante das notificações.
+ *
+ */
+struct notify_fanout_sub {
+  const char *name;                     /* Nome usado nas estatísticas. */
+  notify_fanout_handler_t handler;      /* Consumidor das mensagens. */
+  struct k_msgq *queue;                 /* Fila de ponteiros de net_buf. */
+  enum notify_fanout_policy policy;     /* Política de fila cheia. */
+  struct notify_fanout_sub_stats stats; /* Contadores do assinante. */
+};
+
+/**
+ * @brief Contadores do publicador.
+ *
+ */
+struct notify_fanout_stats {
+  uint32_t published; /* Notificações publicadas. */
+  uint32_t bytes;     /* Bytes publicados. */
+  uint32_t no_buf;    /* Notificações perdidas por falta de buffer. */
+  uint32_t truncated; /* Notificações maiores que NOTIFY_FANOUT_BUF_SIZE. */
+};
+
+/**
+ * @brief Define um assinante com fila de profundidade depth e thread de
+ * prioridade prio. O assinante se registra quando sua thread inicia.
+ *
+ * @param _name Nome do assinante.
+ * @param _handler Handler do tipo notify_fanout_handler_t.
+ * @param _depth Profundidade da fila.
+ * @param _policy Política de fila cheia.
+ * @param _prio Prioridade da thread.
+ */
+#define NOTIFY_FANOUT_SUBSCRIBER_DEFINE(_name, _handler, _depth, _policy,      \
+                                        _prio)                                 \
+  K_MSGQ_DEFINE(_name##_queue, sizeof(struct net_buf *), _depth, 4);           \
+  struct notify_fanout_sub _name = {                                           \
+      .name = #_name,                                                          \
+      .handler = _handler,                                                     \
+      .queue = &_name##_queue,                                                 \
+      .policy = _policy,                                                       \
+  };                                                                           \
+  K_THREAD_DEFINE(_name##_thread, NOTIFY_FANOUT_STACK_SIZE,                    \
+                  notify_fanout_sub_task, &_name, NULL, NULL, _prio, 0, 0)
+
+/**
+ * @brief Tarefa de um assinante: registra o assinante e consome sua fila.
+ * Usada por NOTIFY_FANOUT_SUBSCRIBER_DEFINE.
+ *
+ * @param sub Ponteiro para o assinante.
+ * @param p2 Não utilizado.
+ * @param p3 Não utilizado.
+ */
+void notify_fanout_sub_task(void *sub, void *p2, void *p3);
+
+/**
+ * @brief Publica um payload para todos os assinantes, sem bloquear. Pode ser
+ * chamada do callback de notify do Bluetooth.
+ *
+ * @param data [in] Ponteiro para o payload.
+ * @param len Tamanho do payload.
+ * @return int 0 para sucesso ou -ENOMEM se não houver buffer livre.
+ */
+int notify_fanout_publish(const void *data, uint16_t len);
+
+/**
+ * @brief Copia os contadores do publicador.
+ *
+ * @param stats [out] Ponteiro para estrutura que recebe os contadores.
+ */
+void notify_fanout_get_stats(struct notify_fanout_stats *stats);
+
+/**
+ * @brief Limita a ocupação das filas dos assinantes. Vale a partir da próxima
+ * publicação; o excedente já enfileirado segue a política de cada assinante.
+ *
+ * @param depth Mensagens por fila, de 1 a NOTIFY_FANOUT_MAX_DEPTH; vale
+ * ainda a cota do pool de cada assinante.
+ */
+void notify_fanout_set_depth(uint32_t depth);
+
+/**
+ * @brief Imprime os contadores do publicador e de cada assinante.
+ *
+ */
+void notify_fanout_print_stats(void);
+
+#endif /* NOTIFY_FANOUT_H_ */
@@ -0,0 +1,122 @@
+/**
+ * @file outbound_qos.h
+ * @brief Interface das filas de saída priorizadas do Central. Cada fila
+ * (lane) guarda mensagens inteiras; o escalonador envia um bloco do tamanho
+ * da MTU por vez, sempre preferindo a lane de controle, e limita os blocos
+ * pendentes no controlador para que uma transferência em massa não atrase
+ * uma mensagem de controle por mais de OUTBOUND_QOS_MAX_INFLIGHT blocos.
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef OUTBOUND_QOS_H_
+#define OUTBOUND_QOS_H_
+
+#include <net/buf.h>
+#include <sys/printk.h>
+#include <zephyr.h>
+
+#include "stdint.h"
+
+/**
+ * @brief Lanes de saída, em ordem decrescente de prioridade.
+ *
+ */
+enum outbound_qos_lane {
+  OUTBOUND_QOS_CONTROL = 0, /* Comandos e linhas do console. */
+  OUTBOUND_QOS_BULK = 1,    /* Dados em massa, como a ponte serial. */
+  OUTBOUND_QOS_LANES,
+};
+
+/**
+ * @brief Buffers disponíveis por lane.
+ *
+ */
+#define OUTBOUND_QOS_BUF_COUNT 8
+
+/**
+ * @brief Maior mensagem aceita por lane, em bytes.
+ *
+ */
+#define OUTBOUND_QOS_BUF_SIZE 244
+
+/**
+ * @brief Blocos enviados e ainda não confirmados pela stack Bluetooth.
+ *
+ */
+#define OUTBOUND_QOS_MAX_INFLIGHT 2
+
+/**
+ * @brief Contadores de uma lane.
+ *
+ */
+struct outbound_qos_stats {
+  uint32_t queued;     /* Mensagens aceitas na lane. */
+  uint32_t sent;       /* Mensagens enviadas por completo. */
+  uint32_t chunks;     /* Blocos enviados. */
+  uint32_t bytes;      /* Bytes enviados. */
+  uint32_t dropped;    /* Mensagens descartadas (sem buffer ou sem link). */
+  uint32_t lat_max_us; /* Maior atraso entre enfileirar e enviar. */
+  uint64_t lat_sum_us; /* Soma dos atrasos, para a média. */
+  int64_t first_ms;    /* Uptime do primeiro bloco enviado. */
+  int64_t last_ms;     /* Uptime do último bloco enviado. */
+};
+
+/**
+ * @brief Enfileira uma mensagem em uma lane.
+ *
+ * @param lane Lane de destino.
+ * @param data [in] Ponteiro para a mensagem.
+ * @param len Tamanho da mensagem, até OUTBOUND_QOS_BUF_SIZE.
+ * @param timeout Espera máxima por um buffer livre na lane. Com K_NO_WAIT,
+ * -ENOMEM é contrapressão: o chamador repete ou descarta e a lane não conta a
+ * recusa como descarte.
+ * @return int 0 para sucesso, -EMSGSIZE para mensagem grande demais ou
+ * -ENOMEM se não houver buffer dentro do timeout.
+ */
+int outbound_qos_send(enum outbound_qos_lane lane, const uint8_t *data,
+                      uint16_t len, k_timeout_t timeout);
+
+/**
+ * @brief Limita as mensagens aguardando em uma lane. Reduzir o limite não
+ * descarta nada: as vagas excedentes são retiradas conforme as mensagens
+ * enfileiradas são enviadas.
+ *
+ * @param lane Lane ajustada.
+ * @param depth Mensagens aguardando, de 1 a OUTBOUND_QOS_BUF_COUNT.
+ */
+void outbound_qos_set_depth(enum outbound_qos_lane lane, uint32_t depth);
+
+/**
+ * @brief Ocupação da lane mais cheia, incluindo a mensagem em envio.
+ *
+ * @return uint32_t Porcentagem do limite de mensagens da lane.
+ */
+uint32_t outbound_qos_fill(void);
+
+/**
+ * @brief Descarta as mensagens pendentes e os créditos de envio; chamado
+ * quando a conexão cai.
+ *
+ */
+void outbound_qos_reset(void);
+
+/**
+ * @brief Copia os contadores de uma lane.
+ *
+ * @param lane Lane consultada.
+ * @param stats [out] Ponteiro para estrutura que recebe os contadores.
+ */
+void outbound_qos_get_stats(enum outbound_qos_lane lane,
+                            struct outbound_qos_stats *stats);
+
+/**
+ * @brief Imprime latência e vazão de cada lane.
+ *
+ */
+void outbound_qos_print_stats(void);
+
+#endif /* OUTBOUND_QOS_H_ */
@@ -0,0 +1,88 @@
+/**
+ * @file perf_params.h
+ * @brief Interface dos parâmetros de desempenho do Central ajustáveis em
+ * tempo de execução: escaneamento, conexão, tarefa de entrada e
+ * profundidade das filas do caminho de dados. Os valores são persistidos com
+ * settings (NVS) e ajustados por linhas "perf ..." digitadas no console.
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef PERF_PARAMS_H_
+#define PERF_PARAMS_H_
+
+#include <sys/printk.h>
+#include <zephyr.h>
+
+#include "stdbool.h"
+#include "stdint.h"
+
+/**
+ * @brief Parâmetros ajustáveis.
+ *
+ */
+enum perf_param {
+  PERF_SCAN_INTERVAL,     /* Intervalo de escaneamento, x0,625 ms. */
+  PERF_SCAN_WINDOW,       /* Janela de escaneamento, x0,625 ms. */
+  PERF_SCAN_POLICY,       /* Política de scan_sched. */
+  PERF_CONN_INTERVAL_MIN, /* Intervalo mínimo de conexão, x1,25 ms. */
+  PERF_CONN_INTERVAL_MAX, /* Intervalo máximo de conexão, x1,25 ms. */
+  PERF_CONN_LATENCY,      /* Latência de periférico, em eventos. */
+  PERF_CONN_TIMEOUT,      /* Timeout de supervisão, x10 ms. */
+  PERF_INPUT_SLEEP_MS,    /* Espera da tarefa de entrada entre linhas. */
+  PERF_INPUT_PRIO,        /* Prioridade da tarefa de entrada. */
+  PERF_INPUT_STACK,       /* Pilha usada pela tarefa de entrada, em bytes. */
+  PERF_NOTIFY_DEPTH,      /* Fila de cada assinante de notify_fanout. */
+  PERF_CONTROL_DEPTH,     /* Mensagens aguardando na lane de controle. */
+  PERF_BULK_DEPTH,        /* Mensagens aguardando na lane em massa. */
+  PERF_PARAMS,
+};
+
+/**
+ * @brief Carrega os valores persistidos e aplica as profundidades de fila.
+ * Deve ser chamada antes de ble_central_init e de message_receptor_init.
+ *
+ * @return int 0 para sucesso e um inteiro negativo em caso de falha; em
+ * falha valem os valores padrão.
+ */
+int perf_params_init(void);
+
+/**
+ * @brief Valor atual de um parâmetro.
+ *
+ * @param param Parâmetro consultado.
+ * @return int32_t Valor atual.
+ */
+int32_t perf_params_get(enum perf_param param);
+
+/**
+ * @brief Valida, persiste e aplica um novo valor.
+ *
+ * @param param Parâmetro alterado.
+ * @param value Novo valor.
+ * @return int 0 para sucesso, -EINVAL para valor fora da faixa ou
+ * incompatível com os demais, ou o erro de settings ao persistir.
+ */
+int perf_params_set(enum perf_param param, int32_t value);
+
+/**
+ * @brief Imprime os valores atuais, com unidade e quando são aplicados.
+ *
+ */
+void perf_params_dump(void);
+
+/**
+ * @brief Interpreta uma linha do console. Aceita "perf dump",
+ * "perf set <nome> <valor>", "perf reset" e "perf stats", que imprime os
+ * contadores do caminho de dados, do escaneamento e da sincronização.
+ *
+ * @param line [in] Linha digitada; é modificada durante a análise.
+ * @return true Se a linha era um comando perf e foi tratada.
+ * @return false Se a linha deve seguir para o Peripheral.
+ */
+bool perf_params_command(char *line);
+
+#endif /* PERF_PARAMS_H_ */
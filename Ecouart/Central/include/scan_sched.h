@@ -0,0 +1,145 @@
+/**
+ * @file scan_sched.h
+ * @brief Interface do escalonador de escaneamento do Central. Escolhe entre
+ * escaneamento rápido, lento, passivo ou pausado conforme os links ativos e a
+ * ocupação das filas de saída, cedendo tempo de rádio aos eventos de conexão
+ * durante rajadas e voltando agressivamente após uma desconexão.
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef SCAN_SCHED_H_
+#define SCAN_SCHED_H_
+
+#include <bluetooth/bluetooth.h>
+#include <sys/printk.h>
+#include <zephyr.h>
+
+#include "stdbool.h"
+#include "stdint.h"
+
+/**
+ * @brief Modos de escaneamento.
+ *
+ */
+enum scan_sched_mode {
+  SCAN_SCHED_OFF,     /* Sem escaneamento (conectando ou política legada). */
+  SCAN_SCHED_BOOST,   /* Ativo e contínuo, logo após perder o link. */
+  SCAN_SCHED_FAST,    /* Ativo com o intervalo e a janela de perf_params. */
+  SCAN_SCHED_SLOW,    /* Ativo com ciclo lento, link ocioso. */
+  SCAN_SCHED_PASSIVE, /* Passivo com ciclo lento, link com dados na fila. */
+  SCAN_SCHED_PAUSED,  /* Pausado durante uma rajada. */
+  SCAN_SCHED_MODES,
+};
+
+/**
+ * @brief Políticas selecionáveis por PERF_SCAN_POLICY.
+ *
+ */
+enum scan_sched_policy {
+  SCAN_SCHED_POLICY_LEGACY = 0,   /* Escaneia apenas sem link. */
+  SCAN_SCHED_POLICY_FIXED = 1,    /* Sempre em modo rápido, mesmo com link. */
+  SCAN_SCHED_POLICY_ADAPTIVE = 2, /* Modo escolhido pela carga. */
+};
+
+/**
+ * @brief Período de reavaliação do modo, em milissegundos.
+ *
+ */
+#define SCAN_SCHED_PERIOD_MS 100
+
+/**
+ * @brief Duração do modo contínuo após perder o link, em milissegundos.
+ *
+ */
+#define SCAN_SCHED_BOOST_MS 10000
+
+/**
+ * @brief Ocupação das filas de saída, em porcentagem, que caracteriza uma
+ * rajada.
+ *
+ */
+#define SCAN_SCHED_BURST_FILL 50
+
+/**
+ * @brief Tempo mínimo de pausa após o fim de uma rajada, em milissegundos.
+ *
+ */
+#define SCAN_SCHED_HOLD_MS 500
+
+/**
+ * @brief Contadores do escalonador.
+ *
+ */
+struct scan_sched_stats {
+  uint32_t switches;          /* Trocas de modo aplicadas. */
+  uint32_t errors;            /* Falhas ao aplicar um modo. */
+  uint32_t discoveries;       /* Peripherals achados sem link. */
+  uint32_t background;        /* Achados com o link ativo. */
+  uint32_t discovery_last_ms; /* Última espera até o achado. */
+  uint32_t discovery_max_ms;  /* Maior espera até o achado. */
+  uint64_t discovery_sum_ms;  /* Soma das esperas, para a média. */
+  int64_t residency_ms[SCAN_SCHED_MODES]; /* Tempo em cada modo. */
+};
+
+/**
+ * @brief Passa a escanear; chamada quando a stack Bluetooth está pronta.
+ *
+ */
+void scan_sched_start(void);
+
+/**
+ * @brief Pede a reavaliação imediata do modo, reaplicando os parâmetros.
+ * Usada quando perf_params muda.
+ *
+ */
+void scan_sched_kick(void);
+
+/**
+ * @brief Informa um Peripheral compatível encontrado pelo escaneamento.
+ * Pode ser chamada do callback de escaneamento.
+ *
+ */
+void scan_sched_on_match(void);
+
+/**
+ * @brief Informa que o escaneamento foi interrompido para criar uma conexão.
+ *
+ */
+void scan_sched_connecting(void);
+
+/**
+ * @brief Informa que a conexão em criação falhou.
+ *
+ */
+void scan_sched_connect_failed(void);
+
+/**
+ * @brief Informa um link estabelecido.
+ *
+ */
+void scan_sched_link_up(void);
+
+/**
+ * @brief Informa um link encerrado.
+ *
+ */
+void scan_sched_link_down(void);
+
+/**
+ * @brief Copia os contadores do escalonador.
+ *
+ * @param stats [out] Ponteiro para estrutura que recebe os contadores.
+ */
+void scan_sched_get_stats(struct scan_sched_stats *stats);
+
+/**
+ * @brief Imprime os contadores do escalonador.
+ *
+ */
+void scan_sched_print_stats(void);
+
+#endif /* SCAN_SCHED_H_ */
@@ -0,0 +1,151 @@
+/**
+ * @file time_sync.h
+ * @brief Interface da sincronização de relógio com o Peripheral e da medição
+ * de latência por sentido. Pedidos periódicos na característica 0x2BC8
+ * estimam offset e deriva (estilo NTP, com filtro de menor atraso); os
+ * carimbos que o Peripheral envia para cada escrita separam uplink,
+ * processamento no Peripheral e downlink.
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef TIME_SYNC_H_
+#define TIME_SYNC_H_
+
+#include <bluetooth/conn.h>
+#include <bluetooth/gatt.h>
+#include <sys/byteorder.h>
+#include <sys/printk.h>
+#include <zephyr.h>
+
+#include "ecouart_clock.h"
+#include "stdbool.h"
+#include "stdint.h"
+#include "string.h"
+
+/**
+ * @brief Período dos pedidos logo após a conexão, em milissegundos.
+ *
+ */
+#define TIME_SYNC_FAST_PERIOD_MS 100
+
+/**
+ * @brief Pedidos feitos no período rápido.
+ *
+ */
+#define TIME_SYNC_FAST_REQUESTS 16
+
+/**
+ * @brief Período dos pedidos em regime, em milissegundos.
+ *
+ */
+#define TIME_SYNC_PERIOD_MS 1000
+
+/**
+ * @brief Amostras por ponto do modelo; vale a de menor atraso, em que
+ * pedido e resposta saíram nos primeiros eventos de conexão disponíveis.
+ *
+ */
+#define TIME_SYNC_WINDOW 4
+
+/**
+ * @brief Pontos usados na regressão de offset e deriva.
+ *
+ */
+#define TIME_SYNC_POINTS 16
+
+/**
+ * @brief Escritas acompanhadas à espera do carimbo do Peripheral.
+ *
+ */
+#define TIME_SYNC_TRACKED 32
+
+/**
+ * @brief Contadores de um sentido ou do processamento, em microssegundos.
+ *
+ */
+struct time_sync_lat {
+  uint32_t count; /* Amostras. */
+  int64_t sum_us; /* Soma, para a média. */
+  int32_t min_us; /* Menor valor. */
+  int32_t max_us; /* Maior valor. */
+};
+
+/**
+ * @brief Contadores da sincronização.
+ *
+ */
+struct time_sync_stats {
+  uint32_t requests;             /* Pedidos enviados. */
+  uint32_t responses;            /* Respostas usadas. */
+  uint32_t points;               /* Pontos incluídos no modelo. */
+  uint32_t min_delay_us;         /* Menor atraso de ida e volta observado. */
+  uint32_t stamps;               /* Carimbos recebidos. */
+  uint32_t unmatched;            /* Carimbos sem escrita acompanhada. */
+  struct time_sync_lat uplink;   /* Central -> Peripheral. */
+  struct time_sync_lat proc;     /* Processamento no Peripheral. */
+  struct time_sync_lat downlink; /* Peripheral -> Central. */
+};
+
+/**
+ * @brief Inicia a sincronização com o Peripheral conectado.
+ *
+ * @param conn [in] Ponteiro para estrutura de handle de conexão; uma
+ * referência é mantida até time_sync_stop.
+ * @param handle Handle do valor da característica de sincronização.
+ */
+void time_sync_start(struct bt_conn *conn, uint16_t handle);
+
+/**
+ * @brief Encerra a sincronização; chamada na desconexão. Espera um pedido em
+ * andamento terminar e solta a referência à conexão.
+ *
+ */
+void time_sync_stop(void);
+
+/**
+ * @brief Registra o envio de uma escrita na característica BLE UART WRITE.
+ *
+ */
+void time_sync_on_write(void);
+
+/**
+ * @brief Registra a chegada de um notify na característica BLE UART NOTIFY.
+ *
+ */
+void time_sync_on_echo(void);
+
+/**
+ * @brief Trata uma notificação da característica de sincronização.
+ *
+ * @param data [in] Ponteiro para a resposta ou carimbo.
+ * @param len Tamanho da notificação.
+ */
+void time_sync_on_notify(const uint8_t *data, uint16_t len);
+
+/**
+ * @brief Indica se já há um modelo de offset.
+ *
+ * @return true Se há pelo menos um ponto no modelo.
+ * @return false Caso contrário.
+ */
+bool time_sync_is_locked(void);
+
+/**
+ * @brief Converte um instante do Peripheral para o relógio do Central.
+ *
+ * @param peer_us Instante no relógio do Peripheral.
+ * @return uint64_t Instante correspondente no relógio do Central.
+ */
+uint64_t time_sync_to_local(uint64_t peer_us);
+
+/**
+ * @brief Imprime offset, deriva e as latências por sentido.
+ *
+ */
+void time_sync_print_stats(void);
+
+#endif /* TIME_SYNC_H_ */
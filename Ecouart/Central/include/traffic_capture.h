@@ -0,0 +1,61 @@
+/**
+ * @file traffic_capture.h
+ * @brief Interface da captura de tráfego do Central. No ambiente
+ * nrf52840_dk_capture cada evento do caminho de dados (linha de entrada,
+ * notificação, conexão e desconexão) é impresso no console como uma linha
+ * CAP:, com o instante em microssegundos e o payload em hexadecimal.
+ * Script/replay/ecap.py converte essas linhas em um arquivo btsnoop e gera a
+ * reprodução no Renode. Fora desse ambiente a captura não gera código.
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef TRAFFIC_CAPTURE_H_
+#define TRAFFIC_CAPTURE_H_
+
+#include <sys/printk.h>
+#include <zephyr.h>
+
+#include "stdint.h"
+
+/**
+ * @brief Eventos capturados. O valor é a letra usada na linha CAP:.
+ *
+ */
+enum traffic_capture_event {
+  TRAFFIC_CAPTURE_INPUT = 'I',        /* Linha de entrada enviada. */
+  TRAFFIC_CAPTURE_NOTIFY = 'N',       /* Notificação recebida. */
+  TRAFFIC_CAPTURE_CONNECTED = 'C',    /* Conexão, payload bt_addr_le_t. */
+  TRAFFIC_CAPTURE_DISCONNECTED = 'D', /* Desconexão, payload o motivo. */
+};
+
+/**
+ * @brief Maior payload impresso por evento; o excedente é truncado.
+ *
+ */
+#define TRAFFIC_CAPTURE_PAYLOAD_MAX 244
+
+#if defined(ECOUART_CAPTURE)
+/**
+ * @brief Imprime um evento com o instante informado.
+ *
+ * @param event Evento capturado.
+ * @param cycles Instante do evento, em ciclos de k_cycle_get_32().
+ * @param data [in] Ponteiro para o payload.
+ * @param len Tamanho do payload.
+ */
+void traffic_capture_record(enum traffic_capture_event event, uint32_t cycles,
+                            const void *data, uint16_t len);
+
+#define TRAFFIC_CAPTURE(event, data, len)                                      \
+  traffic_capture_record((event), k_cycle_get_32(), (data), (len))
+#else
+#define TRAFFIC_CAPTURE(event, data, len)                                      \
+  do {                                                                         \
+  } while (0)
+#endif
+
+#endif /* TRAFFIC_CAPTURE_H_ */
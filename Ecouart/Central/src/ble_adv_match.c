@@ -0,0 +1,62 @@
+/**
+ * @file ble_adv_match.c
+ * @brief Implementação da verificação dos dados de advertising.
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "ble_adv_match.h"
+
+enum ble_adv_match_result ble_adv_match_uuid16(const uint8_t *data,
+                                               size_t len, uint16_t uuid) {
+  enum ble_adv_match_result result = BLE_ADV_NO_MATCH;
+  const uint8_t *end = data + len;
+  const uint8_t *next;
+  uint8_t ad_len;
+
+  /* Ponteiros em vez de índices: o laço fica com uma comparação de limite
+   * por estrutura, como o bt_data_parse original. */
+  while (end - data > 1) {
+    ad_len = *data++;
+
+    /* Tamanho zero encerra os dados; estrutura maior que o buffer é
+     * malformada. */
+    if (ad_len == 0) {
+      break;
+    }
+
+    if (ad_len > end - data) {
+      result = BLE_ADV_MALFORMED;
+      break;
+    }
+
+    next = data + ad_len;
+
+    switch (data[0]) {
+    case BLE_ADV_TYPE_UUID16_SOME:
+    case BLE_ADV_TYPE_UUID16_ALL:
+      if ((ad_len - 1) % 2 != 0) {
+        result = BLE_ADV_MALFORMED;
+        break;
+      }
+
+      /* Compara o valor em little-endian direto, sem montar struct
+       * bt_uuid. */
+      for (const uint8_t *value = data + 1; value < next; value += 2) {
+        if ((uint16_t)(value[0] | (value[1] << 8)) == uuid) {
+          return BLE_ADV_MATCH;
+        }
+      }
+      break;
+    default:
+      break;
+    }
+
+    data = next;
+  }
+
+  return result;
+}
@@ -21,16 +21,11 @@
 void ble_central_mtu_updated(struct bt_conn *conn, uint16_t tx, uint16_t rx);
 
 /**
- * @brief Callback que trata a verificação do Peripheral.
+ * @brief Interrompe o escaneamento e inicia a conexão com o Peripheral.
  *
- * @param data [in] Ponteiro para estrutura que contém os dados dos serviços do
- * periférico.
- * @param user_data [in] Dado passado no cadastro do callback, contém o endereço
- * do Peripheral.
- * @return true Em caso de sucesso.
- * @return false EM caso de erro.
+ * @param addr [in] Ponteiro para estrutura que identifica o Peripheral.
  */
-static bool ble_central_eir_found(struct bt_data *data, void *user_data);
+static void ble_central_connect(const bt_addr_le_t *addr);
 
 /**
  * @brief Callback que trata a identificação de um dispositivo em adversiting.
@@ -89,12 +84,6 @@ static void ble_central_connected(struct bt_conn *conn, uint8_t err);
  */
 static void ble_central_disconnected(struct bt_conn *conn, uint8_t reason);
 
-/**
- * @brief Inicializa escaneamento de dispositivo em advertising.
- *
- */
-static void ble_central_start_scan(void);
-
 /**
  * @brief Callback que trata a stack bluetooth após o mesmo estar pronto,
  * procurando por periféricos.
@@ -103,6 +92,71 @@ static void ble_central_start_scan(void);
  */
 static void ble_central_search_for_peripherals(int err);
 
+#if ECOUART_BRIDGE_ENABLED
+/**
+ * @brief Callback da ponte que escreve no Peripheral um bloco lido da UART.
+ *
+ * @param data [in] Ponteiro para os dados lidos.
+ * @param len Tamanho dos dados lidos.
+ * @return int 0 para sucesso e um inteiro negativo em caso de falha.
+ */
+static int ble_central_bridge_rx(const uint8_t *data, size_t len);
+#endif
+
+/**
+ * @brief Callback que trata o fim da troca de MTU.
+ *
+ * @param conn [in] Ponteiro para estrutura de handle de conexão.
+ * @param err Indica se houve erro na troca.
+ * @param params [in] Ponteiro para estrutura dos parâmetros da troca.
+ */
+static void ble_central_mtu_exchanged(struct bt_conn *conn, uint8_t err,
+                                      struct bt_gatt_exchange_params *params);
+
+/**
+ * @brief Callback que trata as notificações de download do diário.
+ *
+ * @param conn [in] Ponteiro para estrutura de handle de conexão.
+ * @param params [in] Ponteiro para estrutura dos parâmetros de inscrição.
+ * @param buf [in] Ponteiro para buffer dos registros.
+ * @param length Tamanho do buffer dos registros.
+ * @return uint8_t BT_GATT_ITER_CONTINUE para manter a inscrição.
+ */
+static uint8_t
+ble_central_journal_notify(struct bt_conn *conn,
+                           struct bt_gatt_subscribe_params *params,
+                           const void *buf, uint16_t length);
+
+/**
+ * @brief Pede ao Peripheral os registros do diário ainda não recebidos.
+ *
+ * @param conn [in] Ponteiro para estrutura de handle de conexão.
+ */
+static void ble_central_journal_request(struct bt_conn *conn);
+
+/**
+ * @brief Callback de confirmação do pedido de download do diário.
+ *
+ * @param conn [in] Ponteiro para estrutura de handle de conexão.
+ * @param err Erro ATT, 0 para sucesso.
+ * @param params [in] Ponteiro para os parâmetros da escrita.
+ */
+static void ble_central_journal_written(struct bt_conn *conn, uint8_t err,
+                                        struct bt_gatt_write_params *params);
+
+/**
+ * @brief Callback que trata as respostas e carimbos da sincronização.
+ *
+ * @param conn [in] Ponteiro para estrutura de handle de conexão.
+ * @param params [in] Ponteiro para estrutura dos parâmetros de inscrição.
+ * @param buf [in] Ponteiro para buffer da mensagem.
+ * @param length Tamanho do buffer da mensagem.
+ * @return uint8_t BT_GATT_ITER_CONTINUE para manter a inscrição.
+ */
+static uint8_t ble_central_sync_notify(struct bt_conn *conn,
+                                       struct bt_gatt_subscribe_params *params,
+                                       const void *buf, uint16_t length);
+
 /**
  * @brief Estrutura interna de variáveis.
  *
@@ -116,8 +170,18 @@ static struct {
   struct bt_gatt_subscribe_params
       subscribe_params;         /* Estrutura de parâmetros para subcribe.  */
   struct bt_conn *default_conn; /* Ponteiro para handle de conexões ativas. */
+  struct k_spinlock lock;       /* Protege default_conn. */
   uint16_t write_handle;        /* Handle da característica de write. */
   struct bt_uuid_16 uuid;       /* Estrutura que define UUIDs. */
+  struct bt_gatt_exchange_params
+      exchange_params; /* Estrutura de parâmetros para troca de MTU. */
+  struct bt_gatt_subscribe_params
+      journal_subscribe_params; /* Inscrição no notify do diário. */
+  struct bt_gatt_write_params
+      journal_write_params;   /* Parâmetros do pedido de download. */
+  uint8_t journal_request[4]; /* Sequência inicial pedida, LE. */
+  struct bt_gatt_subscribe_params
+      sync_subscribe_params; /* Inscrição no notify da sincronização. */
 } self = {
     .conn_callbacks =
         {
@@ -133,72 +197,164 @@ static struct {
     .default_conn = NULL,
     .write_handle = 0,
     .uuid = BT_UUID_INIT_16(0),
+    .exchange_params = {0},
+    .journal_subscribe_params = {0},
+    .journal_write_params = {0},
+    .sync_subscribe_params = {0},
 };
 
 void ble_central_mtu_updated(struct bt_conn *conn, uint16_t tx, uint16_t rx) {
   printk("|BLE CENTRAL| Updated MTU. TX:%d RX:%d bytes.\n", tx, rx);
+
+#if ECOUART_BRIDGE_ENABLED
+  /* Cada escrita carrega até MTU - 3 bytes (cabeçalho ATT). */
+  ecouart_bridge_set_chunk(tx - 3);
+#endif
 }
 
-static bool ble_central_eir_found(struct bt_data *data, void *user_data) {
-  bt_addr_le_t *addr = user_data;
-  int i;
+static void ble_central_mtu_exchanged(struct bt_conn *conn, uint8_t err,
+                                      struct bt_gatt_exchange_params *params) {
+  if (err) {
+    printk("|BLE CENTRAL| MTU exchange failed (err %u).\n", err);
+  }
+}
 
-  printk("|BLE CENTRAL| [AD]: %u data_len %u.\n", data->type, data->data_len);
+static uint8_t
+ble_central_journal_notify(struct bt_conn *conn,
+                           struct bt_gatt_subscribe_params *params,
+                           const void *buf, uint16_t length) {
+  if (!buf) {
+    params->value_handle = 0U;
+    return BT_GATT_ITER_CONTINUE;
+  }
 
-  switch (data->type) {
-  case BT_DATA_UUID16_SOME:
-  case BT_DATA_UUID16_ALL:
-    if (data->data_len % sizeof(uint16_t) != 0U) {
-      printk("|BLE CENTRAL| AD malformed.\n");
-      return true;
-    }
+  journal_client_on_notify(buf, length);
 
-    for (i = 0; i < data->data_len; i += sizeof(uint16_t)) {
-      struct bt_le_conn_param *param;
-      struct bt_uuid *uuid;
-      uint16_t u16;
-      int err;
-
-      memcpy(&u16, &data->data[i], sizeof(u16));
-      uuid = BT_UUID_DECLARE_16(sys_le16_to_cpu(u16));
-      if (bt_uuid_cmp(uuid, BLE_UART_SVC_UUID)) {
-        continue;
-      }
-
-      err = bt_le_scan_stop();
-      if (err) {
-        printk("|BLE CENTRAL| Stop LE scan failed (err %d).\n", err);
-        continue;
-      }
-
-      param = BT_LE_CONN_PARAM_DEFAULT;
-      err = bt_conn_le_create(addr, BT_CONN_LE_CREATE_CONN, param,
-                              &self.default_conn);
-      if (err) {
-        printk("|BLE CENTRAL| Create conn failed (err %d).\n", err);
-        ble_central_start_scan();
-      }
-
-      return false;
-    }
+  return BT_GATT_ITER_CONTINUE;
+}
+
+static void ble_central_journal_written(struct bt_conn *conn, uint8_t err,
+                                        struct bt_gatt_write_params *params) {
+  ARG_UNUSED(conn);
+  ARG_UNUSED(params);
+
+  if (err) {
+    printk("|BLE CENTRAL| Journal request rejected (err %u).\n", err);
   }
+}
+
+static void ble_central_journal_request(struct bt_conn *conn) {
+  int err;
 
-  return true;
+  journal_client_build_request(self.journal_request);
+
+  /* A stack chama func sem checar NULL ao receber a resposta da escrita. */
+  self.journal_write_params.func = ble_central_journal_written;
+  self.journal_write_params.handle =
+      self.journal_subscribe_params.value_handle;
+  self.journal_write_params.offset = 0;
+  self.journal_write_params.data = self.journal_request;
+  self.journal_write_params.length = sizeof(self.journal_request);
+
+  err = bt_gatt_write(conn, &self.journal_write_params);
+  if (err) {
+    printk("|BLE CENTRAL| Journal request failed (err %d).\n", err);
+  }
+}
+
+static uint8_t ble_central_sync_notify(struct bt_conn *conn,
+                                       struct bt_gatt_subscribe_params *params,
+                                       const void *buf, uint16_t length) {
+  if (!buf) {
+    params->value_handle = 0U;
+    return BT_GATT_ITER_CONTINUE;
+  }
+
+  time_sync_on_notify(buf, length);
+
+  return BT_GATT_ITER_CONTINUE;
+}
+
+#if ECOUART_BRIDGE_ENABLED
+static int ble_central_bridge_rx(const uint8_t *data, size_t len) {
+  if (!ble_central_is_ready()) {
+    return -ENOTCONN;
+  }
+
+  /* Dados da ponte são em massa: cedem a vez às linhas do console. Sem
+   * espera: com a lane cheia, a ponte repete e ainda percebe a queda do
+   * link. */
+  return outbound_qos_send(OUTBOUND_QOS_BULK, data, len, K_NO_WAIT);
+}
+#endif
+
+static void ble_central_connect(const bt_addr_le_t *addr) {
+  struct bt_le_conn_param *param;
+  struct bt_conn *conn;
+  k_spinlock_key_t key;
+  int err;
+
+  /* O escalonador não volta a escanear enquanto a conexão é criada. */
+  scan_sched_connecting();
+
+  /* -EALREADY: o escalonador já parou o escaneamento; a conexão segue. Em
+   * outra falha o escalonador reaplica o modo e religa o escaneamento. */
+  err = bt_le_scan_stop();
+  if (err && err != -EALREADY) {
+    printk("|BLE CENTRAL| Stop LE scan failed (err %d).\n", err);
+    scan_sched_connect_failed();
+    return;
+  }
+
+  ECOUART_TRACE(ECOUART_TRACE_CONNECT, 0);
+
+  param = BT_LE_CONN_PARAM(perf_params_get(PERF_CONN_INTERVAL_MIN),
+                           perf_params_get(PERF_CONN_INTERVAL_MAX),
+                           perf_params_get(PERF_CONN_LATENCY),
+                           perf_params_get(PERF_CONN_TIMEOUT));
+  err = bt_conn_le_create(addr, BT_CONN_LE_CREATE_CONN, param, &conn);
+  if (err) {
+    printk("|BLE CENTRAL| Create conn failed (err %d).\n", err);
+    scan_sched_connect_failed();
+    return;
+  }
+
+  key = k_spin_lock(&self.lock);
+  self.default_conn = conn;
+  k_spin_unlock(&self.lock, key);
 }
 
 static void device_found(const bt_addr_le_t *addr, int8_t rssi, uint8_t type,
                          struct net_buf_simple *ad) {
+  enum ble_adv_match_result match;
+
+  ECOUART_TRACE(ECOUART_TRACE_SCAN_REPORT, ad->len);
+
+#if BLE_CENTRAL_LOG_ADV_REPORTS
   char dev[BT_ADDR_LE_STR_LEN];
 
   bt_addr_le_to_str(addr, dev, sizeof(dev));
   printk("|BLE CENTRAL| Device:%s, AD evt type %u, AD data len %u, RSSI %i.\n",
          dev, type, ad->len, rssi);
+#endif
+
+  /* Somente dispositivos que aceitam conexão interessam. */
+  if (type != BT_GAP_ADV_TYPE_ADV_IND &&
+      type != BT_GAP_ADV_TYPE_ADV_DIRECT_IND) {
+    return;
+  }
+
+  /* Verifica se o serviço BLE UART é anunciado. */
+  match = ble_adv_match_uuid16(ad->data, ad->len, BLE_UART_UUID_SVC_VAL);
+  if (match == BLE_ADV_MATCH) {
+    scan_sched_on_match();
 
-  /* Caso o dispostivo possa ser lido e conectado, inicia verificação de seus
-   * serviços. */
-  if (type == BT_GAP_ADV_TYPE_ADV_IND ||
-      type == BT_GAP_ADV_TYPE_ADV_DIRECT_IND) {
-    bt_data_parse(ad, ble_central_eir_found, (void *)addr);
+    /* Com o link ativo, o escaneamento em segundo plano apenas contabiliza. */
+    if (self.default_conn == NULL) {
+      ble_central_connect(addr);
+    }
+  } else if (BLE_CENTRAL_LOG_ADV_REPORTS && match == BLE_ADV_MALFORMED) {
+    printk("|BLE CENTRAL| AD malformed.\n");
   }
 }
 
@@ -212,13 +368,13 @@ static uint8_t ble_central_notify(struct bt_conn *conn,
     return BT_GATT_ITER_CONTINUE;
   }
 
-  char data[length + 1];
-
-  memcpy(data, buf, length);
-  data[length] = '\0';
+  ECOUART_TRACE(ECOUART_TRACE_NOTIFY_RX, length);
+  ecouart_boot_mark(ECOUART_BOOT_FIRST_DATA);
+  time_sync_on_echo();
 
-  printk("|BLE CENTRAL| Notification Received data: %s. Length %u.\n", data,
-         length);
+  /* Consumidores (console, ponte, estatísticas) rodam em suas próprias
+   * threads; aqui só há a cópia para o buffer compartilhado. */
+  notify_fanout_publish(buf, length);
 
   return BT_GATT_ITER_CONTINUE;
 }
@@ -235,6 +391,7 @@ ble_central_discover_func(struct bt_conn *conn, const struct bt_gatt_attr *attr,
   }
 
   printk("|BLE CENTRAL| Discover attribute handle: %u.\n", attr->handle);
+  ECOUART_TRACE(ECOUART_TRACE_DISCOVER_STEP, attr->handle);
 
   /* Identifica o serviço BLE UART. */
   if (!bt_uuid_cmp(self.discover_params.uuid, BLE_UART_SVC_UUID)) {
@@ -274,7 +431,34 @@ ble_central_discover_func(struct bt_conn *conn, const struct bt_gatt_attr *attr,
     if (err) {
       printk("|BLE CENTRAL| Discover failed (err %d).\n", err);
     }
-  } else {
+  } else if (!bt_uuid_cmp(self.discover_params.uuid,
+                          BLE_UART_JOURNAL_CHAR_UUID)) {
+    memcpy(&self.uuid, BT_UUID_GATT_CCC, sizeof(self.uuid));
+    self.discover_params.uuid = &self.uuid.uuid;
+    self.discover_params.start_handle = attr->handle + 2;
+    self.discover_params.type = BT_GATT_DISCOVER_DESCRIPTOR;
+    self.journal_subscribe_params.value_handle =
+        bt_gatt_attr_value_handle(attr);
+
+    /* Continua descoberta para o descritor do diário. */
+    err = bt_gatt_discover(conn, &self.discover_params);
+    if (err) {
+      printk("|BLE CENTRAL| Discover failed (err %d).\n", err);
+    }
+  } else if (!bt_uuid_cmp(self.discover_params.uuid,
+                          BLE_UART_SYNC_CHAR_UUID)) {
+    memcpy(&self.uuid, BT_UUID_GATT_CCC, sizeof(self.uuid));
+    self.discover_params.uuid = &self.uuid.uuid;
+    self.discover_params.start_handle = attr->handle + 2;
+    self.discover_params.type = BT_GATT_DISCOVER_DESCRIPTOR;
+    self.sync_subscribe_params.value_handle = bt_gatt_attr_value_handle(attr);
+
+    /* Continua descoberta para o descritor da sincronização. */
+    err = bt_gatt_discover(conn, &self.discover_params);
+    if (err) {
+      printk("|BLE CENTRAL| Discover failed (err %d).\n", err);
+    }
+  } else if (self.journal_subscribe_params.value_handle == 0) {
     self.subscribe_params.notify = ble_central_notify;
     self.subscribe_params.value = BT_GATT_CCC_NOTIFY;
     self.subscribe_params.ccc_handle = attr->handle;
@@ -283,10 +467,56 @@ ble_central_discover_func(struct bt_conn *conn, const struct bt_gatt_attr *attr,
     if (err && err != -EALREADY) {
       printk("|BLE CENTRAL| Subscribe failed (err %d).\n", err);
     } else {
+      ECOUART_TRACE(ECOUART_TRACE_SUBSCRIBED, 0);
       printk("|BLE CENTRAL| Subscribed!\n");
     }
 
-    return BT_GATT_ITER_STOP;
+    /* Continua descoberta para a característica do diário, se houver. */
+    memcpy(&self.uuid, BLE_UART_JOURNAL_CHAR_UUID, sizeof(self.uuid));
+    self.discover_params.uuid = &self.uuid.uuid;
+    self.discover_params.start_handle = attr->handle + 1;
+    self.discover_params.type = BT_GATT_DISCOVER_CHARACTERISTIC;
+
+    err = bt_gatt_discover(conn, &self.discover_params);
+    if (err) {
+      printk("|BLE CENTRAL| Discover failed (err %d).\n", err);
+    }
+  } else if (self.sync_subscribe_params.value_handle == 0) {
+    self.journal_subscribe_params.notify = ble_central_journal_notify;
+    self.journal_subscribe_params.value = BT_GATT_CCC_NOTIFY;
+    self.journal_subscribe_params.ccc_handle = attr->handle;
+
+    err = bt_gatt_subscribe(conn, &self.journal_subscribe_params);
+    if (err && err != -EALREADY) {
+      printk("|BLE CENTRAL| Journal subscribe failed (err %d).\n", err);
+    } else {
+      /* Recupera o que foi registrado enquanto estava desconectado. */
+      ble_central_journal_request(conn);
+    }
+
+    /* Continua descoberta para a característica de sincronização, se
+     * houver. */
+    memcpy(&self.uuid, BLE_UART_SYNC_CHAR_UUID, sizeof(self.uuid));
+    self.discover_params.uuid = &self.uuid.uuid;
+    self.discover_params.start_handle = attr->handle + 1;
+    self.discover_params.type = BT_GATT_DISCOVER_CHARACTERISTIC;
+
+    err = bt_gatt_discover(conn, &self.discover_params);
+    if (err) {
+      printk("|BLE CENTRAL| Discover failed (err %d).\n", err);
+    }
+  } else {
+    self.sync_subscribe_params.notify = ble_central_sync_notify;
+    self.sync_subscribe_params.value = BT_GATT_CCC_NOTIFY;
+    self.sync_subscribe_params.ccc_handle = attr->handle;
+
+    err = bt_gatt_subscribe(conn, &self.sync_subscribe_params);
+    if (err && err != -EALREADY) {
+      printk("|BLE CENTRAL| Sync subscribe failed (err %d).\n", err);
+      return BT_GATT_ITER_STOP;
+    }
+
+    time_sync_start(conn, self.sync_subscribe_params.value_handle);
   }
 
   return BT_GATT_ITER_STOP;
@@ -294,22 +524,42 @@ ble_central_discover_func(struct bt_conn *conn, const struct bt_gatt_attr *attr,
 
 static void ble_central_connected(struct bt_conn *conn, uint8_t conn_err) {
   char addr[BT_ADDR_LE_STR_LEN];
+  struct bt_conn *old;
+  k_spinlock_key_t key;
   int err;
 
   bt_addr_le_to_str(bt_conn_get_dst(conn), addr, sizeof(addr));
+  ECOUART_TRACE(ECOUART_TRACE_CONNECTED, conn_err);
 
   /* Caso ocorra erro, volta a escanear dispositivos. */
   if (conn_err) {
     printk("|BLE CENTRAL| Failed to connect to %s (%u).\n", addr, conn_err);
 
-    bt_conn_unref(self.default_conn);
+    key = k_spin_lock(&self.lock);
+    old = self.default_conn;
     self.default_conn = NULL;
+    k_spin_unlock(&self.lock, key);
+    if (old) {
+      bt_conn_unref(old);
+    }
 
-    ble_central_start_scan();
+    scan_sched_connect_failed();
     return;
   }
 
+  scan_sched_link_up();
+
   printk("|BLE CENTRAL| Connected: %s.\n", addr);
+  ecouart_boot_mark(ECOUART_BOOT_CONNECTED);
+  TRAFFIC_CAPTURE(TRAFFIC_CAPTURE_CONNECTED, bt_conn_get_dst(conn),
+                  sizeof(bt_addr_le_t));
+
+  /* Diário e ponte aproveitam a maior MTU suportada pelos dois lados. */
+  self.exchange_params.func = ble_central_mtu_exchanged;
+  err = bt_gatt_exchange_mtu(conn, &self.exchange_params);
+  if (err) {
+    printk("|BLE CENTRAL| MTU exchange failed (err %d).\n", err);
+  }
 
   /* Inicializa identificação das características do dispositivos pareado. */
   if (conn == self.default_conn) {
@@ -329,39 +579,76 @@ static void ble_central_connected(struct bt_conn *conn, uint8_t conn_err) {
 }
 
 static void ble_central_disconnected(struct bt_conn *conn, uint8_t reason) {
-  printk("|BLE CENTRAL| Disconnected, (reason %u).\n", reason);
+  struct bt_conn *old;
+  k_spinlock_key_t key;
 
-  /* Decrementa conexão anterior do contador. */
-  if (self.default_conn) {
-    bt_conn_unref(self.default_conn);
-    self.default_conn = NULL;
+  printk("|BLE CENTRAL| Disconnected, (reason %u).\n", reason);
+  ECOUART_TRACE(ECOUART_TRACE_DISCONNECTED, reason);
+  TRAFFIC_CAPTURE(TRAFFIC_CAPTURE_DISCONNECTED, &reason, sizeof(reason));
+
+  notify_fanout_print_stats();
+  outbound_qos_print_stats();
+  scan_sched_print_stats();
+  time_sync_print_stats();
+  time_sync_stop();
+  outbound_qos_reset();
+
+#if ECOUART_BRIDGE_ENABLED
+  ecouart_bridge_print_stats("|BLE CENTRAL|");
+  ecouart_bridge_set_chunk(ECOUART_BRIDGE_CHUNK_DEFAULT);
+#endif
+
+  /* Decrementa conexão anterior do contador; quem ainda a usa tem sua
+   * própria referência. */
+  key = k_spin_lock(&self.lock);
+  old = self.default_conn;
+  self.default_conn = NULL;
+  k_spin_unlock(&self.lock, key);
+  if (old) {
+    bt_conn_unref(old);
   }
 
-  /* Volta a realizar o escaneamento. */
-  ble_central_start_scan();
+  /* Handles descobertos valem apenas para a conexão encerrada. */
+  self.write_handle = 0;
+  self.subscribe_params.value_handle = 0;
+  self.journal_subscribe_params.value_handle = 0;
+  self.sync_subscribe_params.value_handle = 0;
+
+  /* Volta a realizar o escaneamento, no modo contínuo do escalonador. */
+  scan_sched_link_down();
 }
 
-static void ble_central_start_scan(void) {
+int ble_central_scan(const struct bt_le_scan_param *param) {
   int err = 0;
 
-  struct bt_le_scan_param scan_param = {
-      .type = BT_LE_SCAN_TYPE_ACTIVE,
-      .options = BT_LE_SCAN_OPT_NONE,
-      .interval = BT_GAP_SCAN_FAST_INTERVAL,
-      .window = BT_GAP_SCAN_FAST_WINDOW,
-  };
+  err = bt_le_scan_stop();
+  if (err && err != -EALREADY) {
+    printk("|BLE CENTRAL| Stop LE scan failed (err %d).\n", err);
+    return err;
+  }
 
-  err = bt_le_scan_start(&scan_param, device_found);
+  if (param == NULL) {
+    return 0;
+  }
+
+  err = bt_le_scan_start(param, device_found);
   if (err) {
     printk("|BLE CENTRAL| Scanning failed to start (err %d).\n", err);
-    return;
+    return err;
+  }
+
+  ecouart_boot_mark(ECOUART_BOOT_LINK_START);
+  /* Trocas de modo com o link ativo não poluem o console. */
+  if (self.default_conn == NULL) {
+    printk("|BLE CENTRAL| Scanning successfully started.\n");
   }
 
-  printk("|BLE CENTRAL| Scanning successfully started.\n");
+  return 0;
 }
 
 static void ble_central_search_for_peripherals(int err) {
-  ble_central_start_scan();
+  ecouart_boot_mark(ECOUART_BOOT_BT_READY);
+  scan_sched_start();
 }
 
 int ble_central_write_input(uint8_t *buf, uint16_t buf_len) {
@@ -372,8 +659,10 @@ int ble_central_write_input(uint8_t *buf, uint16_t buf_len) {
     return -1;
   }
 
-  err = bt_gatt_write_without_response(self.default_conn, self.write_handle,
-                                       buf, buf_len, false);
+  /* O instante capturado é o da entrada, antes da espera por buffer. */
+  TRAFFIC_CAPTURE(TRAFFIC_CAPTURE_INPUT, buf, buf_len);
+
+  err = outbound_qos_send(OUTBOUND_QOS_CONTROL, buf, buf_len, K_FOREVER);
   if (err) {
     printk("%s: Write cmd failed (%d).\n", __func__, err);
   }
@@ -381,6 +670,88 @@ int ble_central_write_input(uint8_t *buf, uint16_t buf_len) {
   return 0;
 }
 
+int ble_central_write_chunk(const uint8_t *buf, uint16_t len,
+                            bt_gatt_complete_func_t func, void *user_data) {
+  struct bt_conn *conn;
+  int err;
+
+  if (!ble_central_is_ready()) {
+    return -ENOTCONN;
+  }
+
+  /* Chamada pela tarefa de saída: a referência vale até o fim da escrita. */
+  conn = ble_central_get_conn();
+  if (conn == NULL) {
+    return -ENOTCONN;
+  }
+
+  ECOUART_TRACE(ECOUART_TRACE_WRITE, len);
+  err = bt_gatt_write_without_response_cb(conn, self.write_handle, buf, len,
+                                          false, func, user_data);
+  bt_conn_unref(conn);
+  if (!err) {
+    /* Numera como o Peripheral, que conta as escritas recebidas. */
+    time_sync_on_write();
+  }
+
+  return err;
+}
+
+uint16_t ble_central_max_payload(void) {
+  struct bt_conn *conn;
+  uint16_t payload;
+
+  /* Sem conexão, vale o bloco da MTU padrão de 23. */
+  conn = ble_central_get_conn();
+  if (conn == NULL) {
+    return ECOUART_BRIDGE_CHUNK_DEFAULT;
+  }
+
+  payload = bt_gatt_get_mtu(conn) - 3;
+  bt_conn_unref(conn);
+
+  return payload;
+}
+
+void ble_central_update_conn_params(void) {
+  struct bt_conn *conn;
+  int err;
+
+  /* Chamada pelo console de perf_params, fora da thread do Bluetooth. */
+  conn = ble_central_get_conn();
+  if (conn == NULL) {
+    return;
+  }
+
+  err = bt_conn_le_param_update(
+      conn, BT_LE_CONN_PARAM(perf_params_get(PERF_CONN_INTERVAL_MIN),
+                             perf_params_get(PERF_CONN_INTERVAL_MAX),
+                             perf_params_get(PERF_CONN_LATENCY),
+                             perf_params_get(PERF_CONN_TIMEOUT)));
+  bt_conn_unref(conn);
+  if (err) {
+    printk("|BLE CENTRAL| Conn param update failed (err %d).\n", err);
+  }
+}
+
+struct bt_conn *ble_central_get_conn(void) {
+  struct bt_conn *conn = NULL;
+  k_spinlock_key_t key;
+
+  key = k_spin_lock(&self.lock);
+  if (self.default_conn != NULL) {
+    conn = bt_conn_ref(self.default_conn);
+  }
+  k_spin_unlock(&self.lock, key);
+
+  return conn;
+}
+
+bool ble_central_is_ready(void) {
+  return (self.default_conn != NULL && self.write_handle != 0 &&
+          self.subscribe_params.value_handle != 0);
+}
+
 int ble_central_init() {
   int err = 0;
 
@@ -397,5 +768,12 @@ int ble_central_init() {
 
   printk("|BLE CENTRAL| Bluetooth initialized.\n");
 
+#if ECOUART_BRIDGE_ENABLED
+  err = ecouart_bridge_init(ble_central_bridge_rx);
+  if (err) {
+    return err;
+  }
+#endif
+
   return 0;
 }
\ No newline at end of file
@@ -0,0 +1,82 @@
+/**
+ * @file journal_client.c
+ * @brief Implementação do cliente do diário de mensagens do Peripheral.
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "journal_client.h"
+
+/**
+ * @brief Estrutura interna de variáveis.
+ *
+ */
+static struct {
+  uint32_t next_seq;                 /* Próxima sequência esperada. */
+  bool started;                      /* Registro inicial já recebido. */
+  struct journal_client_stats stats; /* Contadores do último download. */
+} self = {
+    .next_seq = 0,
+    .started = false,
+};
+
+void journal_client_build_request(uint8_t request[4]) {
+  memset(&self.stats, 0, sizeof(self.stats));
+  self.stats.start_ms = k_uptime_get();
+  self.started = false;
+
+  sys_put_le32(self.next_seq, request);
+}
+
+void journal_client_on_notify(const uint8_t *data, uint16_t len) {
+  uint16_t offset = 0;
+  uint32_t elapsed_ms;
+  uint32_t seq;
+  uint8_t rec_len;
+
+  self.stats.bytes += len;
+
+  while (offset + JOURNAL_CLIENT_RECORD_HDR <= len) {
+    seq = sys_get_le32(&data[offset]);
+    rec_len = data[offset + 4];
+
+    if (rec_len == 0 && !self.started) {
+      /* Registro inicial: o Peripheral pode ter pulado a sessão anterior,
+       * recebida ao vivo; isso não é uma falha. */
+      self.next_seq = seq;
+      self.started = true;
+      offset += JOURNAL_CLIENT_RECORD_HDR;
+      continue;
+    }
+
+    if (rec_len == 0) {
+      /* Registro final: a sequência é a próxima que o Peripheral usará. */
+      self.next_seq = seq;
+      self.stats.end_ms = k_uptime_get();
+      elapsed_ms = (uint32_t)(self.stats.end_ms - self.stats.start_ms);
+
+      printk("|BLE CENTRAL| Journal download: %u records, %u gaps, %u bytes "
+             "in %u ms, %u B/s.\n",
+             self.stats.records, self.stats.gaps, self.stats.bytes,
+             elapsed_ms,
+             elapsed_ms ? (uint32_t)(self.stats.bytes * 1000ULL / elapsed_ms)
+                        : 0);
+      return;
+    }
+
+    if (seq > self.next_seq) {
+      self.stats.gaps += seq - self.next_seq;
+    }
+    self.next_seq = seq + 1;
+    self.stats.records++;
+
+    offset += JOURNAL_CLIENT_RECORD_HDR + rec_len;
+  }
+}
+
+void journal_client_get_stats(struct journal_client_stats *stats) {
+  *stats = self.stats;
+}
@@ -18,9 +18,16 @@
 void main(void) {
   int err = 1;
 
+  ecouart_boot_mark(ECOUART_BOOT_MAIN);
+
+  /* Parâmetros persistidos valem desde o primeiro escaneamento. */
+  perf_params_init();
+
   /* Inicializa lógica do Central. */
   err = ble_central_init();
   if (err) {
     printk("|BLE CENTRAL| Error initializing Central.\n");
   }
+
+  message_receptor_init();
 }
\ No newline at end of file
@@ -13,33 +13,108 @@
 /**
  * @brief Tarefa que executa recepção da entrada e envio via Bluetooth.
  *
+ * @param p1 Não utilizado.
+ * @param p2 Não utilizado.
+ * @param p3 Não utilizado.
  */
-static void input_task(void);
+static void input_task(void *p1, void *p2, void *p3);
 
 /**
- * @brief Define a tarefa de entrada.
+ * @brief Lê a próxima linha a ser enviada ao Peripheral.
  *
+ * @return char* Ponteiro para a linha lida ou NULL em caso de erro.
  */
-K_THREAD_DEFINE(input, 1024, input_task, NULL, NULL, NULL, 1, 0, 1000);
+static char *message_receptor_getline(void);
 
-static void input_task(void) {
+/**
+ * @brief Pilha da tarefa de entrada, sempre reservada no tamanho máximo:
+ * PERF_INPUT_STACK só limita quanto dela a tarefa usa, sem liberar RAM.
+ *
+ */
+K_THREAD_STACK_DEFINE(input_stack, MESSAGE_RECEPTOR_STACK_MAX);
+
+/**
+ * @brief Estrutura interna de variáveis.
+ *
+ */
+static struct {
+  struct k_thread thread; /* Tarefa de entrada. */
+  k_tid_t tid;            /* Identificador da tarefa, após a criação. */
+} self = {
+    .tid = NULL,
+};
+
+#if defined(CONFIG_CONSOLE_GETLINE)
+static char *message_receptor_getline(void) { return console_getline(); }
+#else
+static char *message_receptor_getline(void) {
+  static char line[MESSAGE_RECEPTOR_SIM_LINE_MAX];
+  static uint32_t count = 0;
+
+  /* Sem console (build nativo), gera as linhas assim que o link estiver
+   * pronto. */
+  while (!ble_central_is_ready()) {
+    k_sleep(K_MSEC(100));
+  }
+
+  if (count == MESSAGE_RECEPTOR_SIM_MESSAGES) {
+    printk("|BLE CENTRAL| Simulated input done: %u lines, uptime %lld ms.\n",
+           count, k_uptime_get());
+    k_sleep(K_FOREVER);
+  }
+
+  snprintk(line, sizeof(line), "message %u", count++);
+
+  return line;
+}
+#endif
+
+void message_receptor_init(void) {
+  size_t stack_size = perf_params_get(PERF_INPUT_STACK);
+
+  /* A espera inicial é a mesma de quando a tarefa era estática. */
+  self.tid = k_thread_create(
+      &self.thread, input_stack,
+      MIN(stack_size, K_THREAD_STACK_SIZEOF(input_stack)), input_task, NULL,
+      NULL, NULL, perf_params_get(PERF_INPUT_PRIO), 0, K_MSEC(1000));
+  k_thread_name_set(self.tid, "input");
+}
+
+void message_receptor_update_priority(void) {
+  if (self.tid != NULL) {
+    k_thread_priority_set(self.tid, perf_params_get(PERF_INPUT_PRIO));
+  }
+}
+
+static void input_task(void *p1, void *p2, void *p3) {
   int err = 0;
   char *recvd_line = NULL;
 
+  ARG_UNUSED(p1);
+  ARG_UNUSED(p2);
+  ARG_UNUSED(p3);
+
+#if defined(CONFIG_CONSOLE_GETLINE)
   console_getline_init();
+#endif
 
   while (true) {
 
-    k_sleep(K_MSEC(100));
+    k_sleep(K_MSEC(perf_params_get(PERF_INPUT_SLEEP_MS)));
 
     printk("|BLE CENTRAL| Enter a line:");
-    recvd_line = console_getline();
+    recvd_line = message_receptor_getline();
 
     if (recvd_line == NULL) {
       printk("|BLE CENTRAL| Error receiving line!\n");
       continue;
     }
 
+    /* Linhas "perf ..." ajustam o Central e não são enviadas. */
+    if (perf_params_command(recvd_line)) {
+      continue;
+    }
+
     printk("|BLE CENTRAL| Sending line:%s\n", recvd_line);
 
     err = ble_central_write_input(recvd_line, strlen(recvd_line));
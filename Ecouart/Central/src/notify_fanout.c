@@ -0,0 +1,206 @@
+/**
+ * @file notify_fanout.c
+ * @brief Implementação da distribuição das notificações recebidas pelo
+ * Central.
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "notify_fanout.h"
+
+/**
+ * @brief Registra um assinante para receber as próximas publicações.
+ *
+ * @param sub [in] Ponteiro para o assinante.
+ * @return int 0 para sucesso ou -ENOMEM se não houver espaço.
+ */
+static int notify_fanout_subscribe(struct notify_fanout_sub *sub);
+
+/**
+ * @brief Entrega um buffer na fila de um assinante, aplicando sua política.
+ *
+ * @param sub [in] Ponteiro para o assinante.
+ * @param buf [in] Ponteiro para o buffer publicado.
+ */
+static void notify_fanout_enqueue(struct notify_fanout_sub *sub,
+                                  struct net_buf *buf);
+
+/**
+ * @brief Ocupação máxima da fila de cada assinante: o limite configurado,
+ * restrito à cota do pool.
+ *
+ * @return uint32_t Mensagens por fila.
+ */
+static uint32_t notify_fanout_depth(void);
+
+BUILD_ASSERT(NOTIFY_FANOUT_BUF_COUNT >= 2 * NOTIFY_FANOUT_MAX_SUBS + 1,
+             "Pool too small for one queued message per subscriber");
+
+/**
+ * @brief Pool dos buffers compartilhados. Os dados de usuário guardam o
+ * instante da publicação, em ciclos.
+ *
+ */
+NET_BUF_POOL_DEFINE(notify_fanout_pool, NOTIFY_FANOUT_BUF_COUNT,
+                    NOTIFY_FANOUT_BUF_SIZE, sizeof(uint32_t), NULL);
+
+/**
+ * @brief Estrutura interna de variáveis.
+ *
+ */
+static struct {
+  struct notify_fanout_sub *subs[NOTIFY_FANOUT_MAX_SUBS]; /* Assinantes. */
+  atomic_t sub_count;               /* Assinantes registrados em subs. */
+  struct k_spinlock lock;           /* Serializa os registros. */
+  struct notify_fanout_stats stats; /* Contadores do publicador. */
+  atomic_t depth;                   /* Ocupação máxima de cada fila. */
+} self = {
+    .sub_count = ATOMIC_INIT(0),
+    .depth = ATOMIC_INIT(NOTIFY_FANOUT_MAX_DEPTH),
+};
+
+static int notify_fanout_subscribe(struct notify_fanout_sub *sub) {
+  k_spinlock_key_t key = k_spin_lock(&self.lock);
+  atomic_val_t count = atomic_get(&self.sub_count);
+
+  if (count == NOTIFY_FANOUT_MAX_SUBS) {
+    k_spin_unlock(&self.lock, key);
+    return -ENOMEM;
+  }
+
+  /* O slot é preenchido antes do contador, que é o que o publicador lê. */
+  self.subs[count] = sub;
+  atomic_inc(&self.sub_count);
+  k_spin_unlock(&self.lock, key);
+
+  return 0;
+}
+
+static uint32_t notify_fanout_depth(void) {
+  atomic_val_t count = MAX(atomic_get(&self.sub_count), 1);
+  uint32_t share = (NOTIFY_FANOUT_BUF_COUNT - 1) / count - 1;
+
+  return MIN((uint32_t)atomic_get(&self.depth), share);
+}
+
+static void notify_fanout_enqueue(struct notify_fanout_sub *sub,
+                                  struct net_buf *buf) {
+  uint32_t depth = notify_fanout_depth();
+  struct net_buf *oldest;
+  uint32_t used;
+
+  net_buf_ref(buf);
+
+  while (k_msgq_num_used_get(sub->queue) >= depth ||
+         k_msgq_put(sub->queue, &buf, K_NO_WAIT) != 0) {
+    sub->stats.dropped++;
+
+    if (sub->policy == NOTIFY_FANOUT_DROP_NEWEST) {
+      net_buf_unref(buf);
+      return;
+    }
+
+    /* Abre espaço descartando a mensagem mais antiga. */
+    if (k_msgq_get(sub->queue, &oldest, K_NO_WAIT) == 0) {
+      net_buf_unref(oldest);
+    }
+  }
+
+  used = k_msgq_num_used_get(sub->queue);
+  if (used > sub->stats.high_water) {
+    sub->stats.high_water = used;
+  }
+}
+
+void notify_fanout_sub_task(void *p1, void *p2, void *p3) {
+  struct notify_fanout_sub *sub = p1;
+  struct net_buf *buf;
+  uint32_t lat_us;
+
+  ARG_UNUSED(p2);
+  ARG_UNUSED(p3);
+
+  if (notify_fanout_subscribe(sub)) {
+    printk("|FANOUT| No room for subscriber %s.\n", sub->name);
+    return;
+  }
+
+  while (true) {
+    k_msgq_get(sub->queue, &buf, K_FOREVER);
+
+    lat_us = k_cyc_to_us_floor32(k_cycle_get_32() -
+                                 *(uint32_t *)net_buf_user_data(buf));
+    sub->stats.delivered++;
+    sub->stats.lat_sum_us += lat_us;
+    if (lat_us > sub->stats.lat_max_us) {
+      sub->stats.lat_max_us = lat_us;
+    }
+
+    sub->handler(sub, buf);
+    net_buf_unref(buf);
+  }
+}
+
+int notify_fanout_publish(const void *data, uint16_t len) {
+  struct net_buf *buf;
+  atomic_val_t count;
+
+  buf = net_buf_alloc(&notify_fanout_pool, K_NO_WAIT);
+  if (buf == NULL) {
+    self.stats.no_buf++;
+    return -ENOMEM;
+  }
+
+  /* Única cópia: do buffer da stack Bluetooth para o buffer compartilhado. */
+  if (len > NOTIFY_FANOUT_BUF_SIZE) {
+    self.stats.truncated++;
+    len = NOTIFY_FANOUT_BUF_SIZE;
+  }
+  net_buf_add_mem(buf, data, len);
+  *(uint32_t *)net_buf_user_data(buf) = k_cycle_get_32();
+
+  self.stats.published++;
+  self.stats.bytes += len;
+
+  count = atomic_get(&self.sub_count);
+  for (atomic_val_t i = 0; i < count; i++) {
+    notify_fanout_enqueue(self.subs[i], buf);
+  }
+
+  /* Libera a referência do publicador; os assinantes mantêm as suas. */
+  net_buf_unref(buf);
+
+  return 0;
+}
+
+void notify_fanout_get_stats(struct notify_fanout_stats *stats) {
+  *stats = self.stats;
+}
+
+void notify_fanout_set_depth(uint32_t depth) {
+  atomic_set(&self.depth, CLAMP(depth, 1, NOTIFY_FANOUT_MAX_DEPTH));
+}
+
+void notify_fanout_print_stats(void) {
+  struct notify_fanout_sub *sub;
+  atomic_val_t count = atomic_get(&self.sub_count);
+
+  printk("|FANOUT| published=%u bytes=%u no_buf=%u truncated=%u depth=%u.\n",
+         self.stats.published, self.stats.bytes, self.stats.no_buf,
+         self.stats.truncated, notify_fanout_depth());
+
+  for (atomic_val_t i = 0; i < count; i++) {
+    sub = self.subs[i];
+    printk("|FANOUT| %s delivered=%u dropped=%u high_water=%u "
+           "lat_avg_us=%u lat_max_us=%u.\n",
+           sub->name, sub->stats.delivered, sub->stats.dropped,
+           sub->stats.high_water,
+           sub->stats.delivered
+               ? (uint32_t)(sub->stats.lat_sum_us / sub->stats.delivered)
+               : 0,
+           sub->stats.lat_max_us);
+  }
+}
@@ -0,0 +1,96 @@
+/**
+ * @file notify_sinks.c
+ * @brief Assinantes padrão das notificações recebidas pelo Central: console
+ * (ou a ponte serial, no ambiente nrf52840_dk_bridge) e estatísticas.
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "ecouart_bridge.h"
+#include "notify_fanout.h"
+
+#if ECOUART_BRIDGE_ENABLED
+/**
+ * @brief Escreve o payload sem formatação na UART da ponte.
+ *
+ * @param sub [in] Ponteiro para o assinante.
+ * @param buf [in] Buffer compartilhado com o payload.
+ */
+static void notify_sink_bridge(struct notify_fanout_sub *sub,
+                               struct net_buf *buf) {
+  ARG_UNUSED(sub);
+
+  ecouart_bridge_write(buf->data, buf->len);
+}
+
+/**
+ * @brief A ponte não pode perder bytes antigos em favor de novos: descarta a
+ * mensagem que chega e mantém a ordem do que já foi aceito.
+ *
+ */
+NOTIFY_FANOUT_SUBSCRIBER_DEFINE(bridge_sink, notify_sink_bridge, 8,
+                                NOTIFY_FANOUT_DROP_NEWEST, 2);
+#else
+/**
+ * @brief Imprime o payload no console.
+ *
+ * @param sub [in] Ponteiro para o assinante.
+ * @param buf [in] Buffer compartilhado com o payload.
+ */
+static void notify_sink_console(struct notify_fanout_sub *sub,
+                                struct net_buf *buf) {
+  ARG_UNUSED(sub);
+
+  printk("|BLE CENTRAL| Notification Received data: %.*s. Length %u.\n",
+         buf->len, buf->data, buf->len);
+}
+
+/**
+ * @brief O console é o consumidor mais lento; descarta as mensagens mais
+ * antigas para mostrar sempre as mais recentes.
+ *
+ */
+NOTIFY_FANOUT_SUBSCRIBER_DEFINE(console_sink, notify_sink_console, 8,
+                                NOTIFY_FANOUT_DROP_OLDEST, 5);
+#endif
+
+/**
+ * @brief Contadores do assinante de estatísticas.
+ *
+ */
+static struct {
+  uint32_t messages; /* Mensagens consumidas. */
+  uint32_t bytes;    /* Bytes consumidos. */
+  int64_t first_ms;  /* Uptime da primeira mensagem. */
+  int64_t last_ms;   /* Uptime da última mensagem. */
+} stats;
+
+/**
+ * @brief Acumula mensagens e bytes para a vazão de notificações.
+ *
+ * @param sub [in] Ponteiro para o assinante.
+ * @param buf [in] Buffer compartilhado com o payload.
+ */
+static void notify_sink_stats(struct notify_fanout_sub *sub,
+                              struct net_buf *buf) {
+  ARG_UNUSED(sub);
+
+  stats.last_ms = k_uptime_get();
+  if (stats.messages == 0) {
+    stats.first_ms = stats.last_ms;
+  }
+  stats.messages++;
+  stats.bytes += buf->len;
+
+  if ((stats.messages % 100) == 0 && stats.last_ms > stats.first_ms) {
+    printk("|FANOUT| stats %u messages, %u bytes, %u B/s.\n", stats.messages,
+           stats.bytes,
+           (uint32_t)(stats.bytes * 1000LL / (stats.last_ms - stats.first_ms)));
+  }
+}
+
+NOTIFY_FANOUT_SUBSCRIBER_DEFINE(stats_sink, notify_sink_stats, 16,
+                                NOTIFY_FANOUT_DROP_OLDEST, 6);
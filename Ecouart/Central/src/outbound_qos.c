@@ -0,0 +1,390 @@
+/**
+ * @file outbound_qos.c
+ * @brief Implementação das filas de saída priorizadas do Central.
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "outbound_qos.h"
+
+#include "ble_central.h"
+
+struct outbound_qos_lane_state;
+
+/**
+ * @brief Callback da stack Bluetooth quando um bloco deixa o buffer de ATT.
+ *
+ * @param conn [in] Ponteiro para estrutura de handle de conexão.
+ * @param user_data Não utilizado.
+ */
+static void outbound_qos_chunk_done(struct bt_conn *conn, void *user_data);
+
+/**
+ * @brief Escolhe a mensagem a ser continuada: a atual da lane de controle,
+ * a próxima da lane de controle, a atual da lane em massa ou a próxima dela.
+ *
+ * @return enum outbound_qos_lane Lane escolhida ou OUTBOUND_QOS_LANES se não
+ * houver nada a enviar.
+ */
+static enum outbound_qos_lane outbound_qos_pick(void);
+
+/**
+ * @brief Descarta a mensagem atual e as pendentes de uma lane.
+ *
+ * @param lane Lane esvaziada.
+ */
+static void outbound_qos_flush(enum outbound_qos_lane lane);
+
+/**
+ * @brief Libera uma mensagem e devolve sua vaga à lane, a menos que a vaga
+ * tenha sido retirada por outbound_qos_set_depth. Chamada com outbound_lock.
+ *
+ * @param state [in] Ponteiro para o estado da lane.
+ * @param buf [in] Ponteiro para a mensagem liberada.
+ */
+static void outbound_qos_release(struct outbound_qos_lane_state *state,
+                                 struct net_buf *buf);
+
+/**
+ * @brief Tarefa que escalona os blocos das lanes.
+ *
+ */
+static void outbound_qos_task(void);
+
+/**
+ * @brief Pools separados: a lane em massa cheia não toma buffers do controle.
+ * Os dados de usuário guardam o instante em que a mensagem foi enfileirada.
+ *
+ */
+NET_BUF_POOL_DEFINE(outbound_control_pool, OUTBOUND_QOS_BUF_COUNT,
+                    OUTBOUND_QOS_BUF_SIZE, sizeof(uint32_t), NULL);
+NET_BUF_POOL_DEFINE(outbound_bulk_pool, OUTBOUND_QOS_BUF_COUNT,
+                    OUTBOUND_QOS_BUF_SIZE, sizeof(uint32_t), NULL);
+
+/**
+ * @brief Vagas de cada lane; outbound_qos_set_depth ajusta a contagem.
+ *
+ */
+K_SEM_DEFINE(outbound_control_slots, OUTBOUND_QOS_BUF_COUNT,
+             OUTBOUND_QOS_BUF_COUNT);
+K_SEM_DEFINE(outbound_bulk_slots, OUTBOUND_QOS_BUF_COUNT,
+             OUTBOUND_QOS_BUF_COUNT);
+
+/**
+ * @brief Sinaliza mensagens novas ao escalonador.
+ *
+ */
+K_SEM_DEFINE(outbound_work_sem, 0, 1);
+
+/**
+ * @brief Créditos de blocos pendentes no controlador.
+ *
+ */
+K_SEM_DEFINE(outbound_credit_sem, OUTBOUND_QOS_MAX_INFLIGHT,
+             OUTBOUND_QOS_MAX_INFLIGHT);
+
+/**
+ * @brief Define a tarefa do escalonador, acima da tarefa de entrada.
+ *
+ */
+K_THREAD_DEFINE(outbound, 1024, outbound_qos_task, NULL, NULL, NULL, 0, 0, 0);
+
+/**
+ * @brief Filas das mensagens aguardando em cada lane.
+ *
+ */
+K_FIFO_DEFINE(outbound_control_fifo);
+K_FIFO_DEFINE(outbound_bulk_fifo);
+
+/**
+ * @brief Protege a mensagem atual e os contadores das lanes.
+ *
+ */
+K_MUTEX_DEFINE(outbound_lock);
+
+/**
+ * @brief Estado de uma lane.
+ *
+ */
+struct outbound_qos_lane_state {
+  struct net_buf_pool *pool;       /* Pool de buffers da lane. */
+  struct k_sem *slots;             /* Vagas livres, até depth. */
+  uint32_t depth;                  /* Limite de mensagens da lane. */
+  uint32_t debt;                   /* Vagas ainda a retirar de slots. */
+  struct k_fifo *fifo;             /* Mensagens aguardando. */
+  struct net_buf *current;         /* Mensagem em envio, parcialmente. */
+  struct outbound_qos_stats stats; /* Contadores da lane. */
+};
+
+/**
+ * @brief Estrutura interna de variáveis.
+ *
+ */
+static struct {
+  struct outbound_qos_lane_state lanes[OUTBOUND_QOS_LANES]; /* Lanes. */
+  atomic_t flush; /* Pedido de descarte feito por outbound_qos_reset. */
+} self = {
+    .lanes =
+        {
+            [OUTBOUND_QOS_CONTROL] =
+                {
+                    .pool = &outbound_control_pool,
+                    .slots = &outbound_control_slots,
+                    .depth = OUTBOUND_QOS_BUF_COUNT,
+                    .debt = 0,
+                    .fifo = &outbound_control_fifo,
+                    .current = NULL,
+                },
+            [OUTBOUND_QOS_BULK] =
+                {
+                    .pool = &outbound_bulk_pool,
+                    .slots = &outbound_bulk_slots,
+                    .depth = OUTBOUND_QOS_BUF_COUNT,
+                    .debt = 0,
+                    .fifo = &outbound_bulk_fifo,
+                    .current = NULL,
+                },
+        },
+    .flush = ATOMIC_INIT(0),
+};
+
+static void outbound_qos_chunk_done(struct bt_conn *conn, void *user_data) {
+  ARG_UNUSED(conn);
+  ARG_UNUSED(user_data);
+
+  k_sem_give(&outbound_credit_sem);
+}
+
+static enum outbound_qos_lane outbound_qos_pick(void) {
+  struct outbound_qos_lane_state *lane;
+
+  for (int i = 0; i < OUTBOUND_QOS_LANES; i++) {
+    lane = &self.lanes[i];
+
+    if (lane->current == NULL) {
+      lane->current = net_buf_get(lane->fifo, K_NO_WAIT);
+    }
+    if (lane->current != NULL) {
+      return i;
+    }
+  }
+
+  return OUTBOUND_QOS_LANES;
+}
+
+static void outbound_qos_release(struct outbound_qos_lane_state *state,
+                                 struct net_buf *buf) {
+  net_buf_unref(buf);
+
+  if (state->debt > 0) {
+    state->debt--;
+  } else {
+    k_sem_give(state->slots);
+  }
+}
+
+static void outbound_qos_flush(enum outbound_qos_lane lane) {
+  struct outbound_qos_lane_state *state = &self.lanes[lane];
+  struct net_buf *buf;
+
+  if (state->current != NULL) {
+    outbound_qos_release(state, state->current);
+    state->current = NULL;
+    state->stats.dropped++;
+  }
+
+  while ((buf = net_buf_get(state->fifo, K_NO_WAIT)) != NULL) {
+    outbound_qos_release(state, buf);
+    state->stats.dropped++;
+  }
+}
+
+static void outbound_qos_task(void) {
+  struct outbound_qos_lane_state *state;
+  enum outbound_qos_lane lane;
+  struct net_buf *buf;
+  uint16_t chunk;
+  uint32_t lat_us;
+  int err;
+
+  while (true) {
+    /* Um crédito por bloco limita o que fica na frente do controle. */
+    k_sem_take(&outbound_credit_sem, K_FOREVER);
+
+    k_mutex_lock(&outbound_lock, K_FOREVER);
+    /* Só esta tarefa mexe em current, então o descarte é feito aqui. */
+    if (atomic_clear(&self.flush)) {
+      for (int i = 0; i < OUTBOUND_QOS_LANES; i++) {
+        outbound_qos_flush(i);
+      }
+    }
+    lane = outbound_qos_pick();
+    k_mutex_unlock(&outbound_lock);
+
+    if (lane == OUTBOUND_QOS_LANES) {
+      k_sem_give(&outbound_credit_sem);
+      k_sem_take(&outbound_work_sem, K_FOREVER);
+      continue;
+    }
+
+    state = &self.lanes[lane];
+    buf = state->current;
+    chunk = MIN(buf->len, ble_central_max_payload());
+
+    err = ble_central_write_chunk(buf->data, chunk, outbound_qos_chunk_done,
+                                  NULL);
+
+    if (err) {
+      k_sem_give(&outbound_credit_sem);
+
+      if (ble_central_is_ready()) {
+        /* Sem buffer na stack: tenta o mesmo bloco em seguida. */
+        k_sleep(K_MSEC(1));
+      } else {
+        /* Sem link não há como entregar; a lane é esvaziada. */
+        k_mutex_lock(&outbound_lock, K_FOREVER);
+        outbound_qos_flush(lane);
+        k_mutex_unlock(&outbound_lock);
+      }
+      continue;
+    }
+
+    k_mutex_lock(&outbound_lock, K_FOREVER);
+    state->stats.chunks++;
+    state->stats.bytes += chunk;
+    state->stats.last_ms = k_uptime_get();
+    if (state->stats.first_ms == 0) {
+      state->stats.first_ms = state->stats.last_ms;
+    }
+
+    net_buf_pull(buf, chunk);
+    if (buf->len == 0) {
+      lat_us = k_cyc_to_us_floor32(k_cycle_get_32() -
+                                   *(uint32_t *)net_buf_user_data(buf));
+      state->stats.sent++;
+      state->stats.lat_sum_us += lat_us;
+      if (lat_us > state->stats.lat_max_us) {
+        state->stats.lat_max_us = lat_us;
+      }
+
+      outbound_qos_release(state, buf);
+      state->current = NULL;
+    }
+    k_mutex_unlock(&outbound_lock);
+  }
+}
+
+int outbound_qos_send(enum outbound_qos_lane lane, const uint8_t *data,
+                      uint16_t len, k_timeout_t timeout) {
+  struct outbound_qos_lane_state *state = &self.lanes[lane];
+  struct net_buf *buf;
+
+  if (len > OUTBOUND_QOS_BUF_SIZE) {
+    return -EMSGSIZE;
+  }
+
+  /* Com uma vaga garantida, o pool sempre tem um buffer livre. */
+  if (k_sem_take(state->slots, timeout) == 0) {
+    buf = net_buf_alloc(state->pool, K_NO_WAIT);
+  } else {
+    buf = NULL;
+  }
+  if (buf == NULL) {
+    if (!K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+      k_mutex_lock(&outbound_lock, K_FOREVER);
+      state->stats.dropped++;
+      k_mutex_unlock(&outbound_lock);
+    }
+    return -ENOMEM;
+  }
+
+  net_buf_add_mem(buf, data, len);
+  *(uint32_t *)net_buf_user_data(buf) = k_cycle_get_32();
+
+  k_mutex_lock(&outbound_lock, K_FOREVER);
+  state->stats.queued++;
+  k_mutex_unlock(&outbound_lock);
+
+  net_buf_put(state->fifo, buf);
+  k_sem_give(&outbound_work_sem);
+
+  return 0;
+}
+
+void outbound_qos_set_depth(enum outbound_qos_lane lane, uint32_t depth) {
+  struct outbound_qos_lane_state *state = &self.lanes[lane];
+
+  depth = CLAMP(depth, 1, OUTBOUND_QOS_BUF_COUNT);
+
+  k_mutex_lock(&outbound_lock, K_FOREVER);
+  for (; state->depth > depth; state->depth--) {
+    /* Vaga ocupada: é retirada quando a mensagem for liberada. */
+    if (k_sem_take(state->slots, K_NO_WAIT) != 0) {
+      state->debt++;
+    }
+  }
+  for (; state->depth < depth; state->depth++) {
+    if (state->debt > 0) {
+      state->debt--;
+    } else {
+      k_sem_give(state->slots);
+    }
+  }
+  k_mutex_unlock(&outbound_lock);
+}
+
+uint32_t outbound_qos_fill(void) {
+  struct outbound_qos_lane_state *state;
+  uint32_t held;
+  uint32_t fill = 0;
+
+  k_mutex_lock(&outbound_lock, K_FOREVER);
+  for (int i = 0; i < OUTBOUND_QOS_LANES; i++) {
+    state = &self.lanes[i];
+    /* Vagas em dívida ainda estão ocupadas por mensagens. */
+    held = state->depth + state->debt - k_sem_count_get(state->slots);
+    fill = MAX(fill, held * 100 / state->depth);
+  }
+  k_mutex_unlock(&outbound_lock);
+
+  return fill;
+}
+
+void outbound_qos_reset(void) {
+  atomic_set(&self.flush, 1);
+
+  /* Confirmações da conexão encerrada podem não chegar mais. */
+  for (int i = 0; i < OUTBOUND_QOS_MAX_INFLIGHT; i++) {
+    k_sem_give(&outbound_credit_sem);
+  }
+  k_sem_give(&outbound_work_sem);
+}
+
+void outbound_qos_get_stats(enum outbound_qos_lane lane,
+                            struct outbound_qos_stats *stats) {
+  k_mutex_lock(&outbound_lock, K_FOREVER);
+  *stats = self.lanes[lane].stats;
+  k_mutex_unlock(&outbound_lock);
+}
+
+void outbound_qos_print_stats(void) {
+  static const char *const names[] = {"control", "bulk"};
+  struct outbound_qos_stats stats;
+  int64_t elapsed_ms;
+
+  for (int i = 0; i < OUTBOUND_QOS_LANES; i++) {
+    outbound_qos_get_stats(i, &stats);
+    elapsed_ms = stats.last_ms - stats.first_ms;
+
+    printk("|QOS| %s queued=%u sent=%u chunks=%u bytes=%u dropped=%u "
+           "lat_avg_us=%u lat_max_us=%u rate=%u B/s.\n",
+           names[i], stats.queued, stats.sent, stats.chunks, stats.bytes,
+           stats.dropped,
+           stats.sent ? (uint32_t)(stats.lat_sum_us / stats.sent) : 0,
+           stats.lat_max_us,
+           elapsed_ms > 0 ? (uint32_t)(stats.bytes * 1000LL / elapsed_ms) : 0);
+  }
+}
@@ -0,0 +1,425 @@
+/**
+ * @file perf_params.c
+ * @brief Implementação dos parâmetros de desempenho ajustáveis do Central.
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "perf_params.h"
+
+#include <bluetooth/gap.h>
+#if defined(CONFIG_SETTINGS)
+#include <settings/settings.h>
+#endif
+
+#include "ble_central.h"
+#include "message_receptor.h"
+#include "notify_fanout.h"
+#include "outbound_qos.h"
+#include "scan_sched.h"
+#include "stdlib.h"
+#include "string.h"
+#include "time_sync.h"
+
+/**
+ * @brief Descrição de um parâmetro.
+ *
+ */
+struct perf_param_desc {
+  const char *name;    /* Nome no console e chave em settings. */
+  const char *unit;    /* Unidade exibida por perf dump. */
+  const char *applied; /* Quando o novo valor passa a valer. */
+  int32_t min;         /* Menor valor aceito. */
+  int32_t max;         /* Maior valor aceito. */
+  int32_t def;         /* Valor padrão. */
+  void (*apply)(enum perf_param param); /* Aplica o valor, ou NULL. */
+};
+
+/**
+ * @brief Aplica as profundidades de fila.
+ *
+ * @param param Parâmetro alterado.
+ */
+static void perf_params_apply_depth(enum perf_param param);
+
+/**
+ * @brief Reaplica o modo de escaneamento com os novos parâmetros.
+ *
+ * @param param Não utilizado.
+ */
+static void perf_params_apply_scan(enum perf_param param);
+
+/**
+ * @brief Pede ao Peripheral conectado os novos parâmetros de conexão.
+ *
+ * @param param Não utilizado.
+ */
+static void perf_params_apply_conn(enum perf_param param);
+
+/**
+ * @brief Aplica a prioridade da tarefa de entrada.
+ *
+ * @param param Não utilizado.
+ */
+static void perf_params_apply_prio(enum perf_param param);
+
+/**
+ * @brief Verifica as restrições entre parâmetros de um conjunto de valores.
+ *
+ * @param values [in] Valores de todos os parâmetros.
+ * @return true Se o conjunto é válido.
+ * @return false Caso contrário.
+ */
+static bool perf_params_consistent(const int32_t *values);
+
+/**
+ * @brief Procura um parâmetro pelo nome.
+ *
+ * @param name [in] Nome procurado.
+ * @return enum perf_param Parâmetro ou PERF_PARAMS se não existir.
+ */
+static enum perf_param perf_params_find(const char *name);
+
+/**
+ * @brief Parâmetros, na ordem de enum perf_param. Os padrões são as
+ * constantes usadas antes de os valores serem ajustáveis.
+ *
+ */
+static const struct perf_param_desc perf_params_desc[PERF_PARAMS] = {
+    [PERF_SCAN_INTERVAL] = {"scan_interval", "x0.625 ms", "live", 0x0004,
+                            0x4000, BT_GAP_SCAN_FAST_INTERVAL,
+                            perf_params_apply_scan},
+#if defined(ECOUART_FAST_START)
+    /* Escaneamento contínuo: nenhum advertising cai fora da janela. */
+    [PERF_SCAN_WINDOW] = {"scan_window", "x0.625 ms", "live", 0x0004, 0x4000,
+                          BT_GAP_SCAN_FAST_INTERVAL, perf_params_apply_scan},
+#else
+    [PERF_SCAN_WINDOW] = {"scan_window", "x0.625 ms", "live", 0x0004, 0x4000,
+                          BT_GAP_SCAN_FAST_WINDOW, perf_params_apply_scan},
+#endif
+    [PERF_SCAN_POLICY] = {"scan_policy", "0 legacy/1 fixed/2 adaptive",
+                          "live", SCAN_SCHED_POLICY_LEGACY,
+                          SCAN_SCHED_POLICY_ADAPTIVE,
+                          SCAN_SCHED_POLICY_ADAPTIVE, perf_params_apply_scan},
+    [PERF_CONN_INTERVAL_MIN] = {"conn_interval_min", "x1.25 ms", "live", 6,
+                                3200, BT_GAP_INIT_CONN_INT_MIN,
+                                perf_params_apply_conn},
+    [PERF_CONN_INTERVAL_MAX] = {"conn_interval_max", "x1.25 ms", "live", 6,
+                                3200, BT_GAP_INIT_CONN_INT_MAX,
+                                perf_params_apply_conn},
+    [PERF_CONN_LATENCY] = {"conn_latency", "events", "live", 0, 499, 0,
+                           perf_params_apply_conn},
+    [PERF_CONN_TIMEOUT] = {"conn_timeout", "x10 ms", "live", 10, 3200, 400,
+                           perf_params_apply_conn},
+    [PERF_INPUT_SLEEP_MS] = {"input_sleep_ms", "ms", "live", 0, 10000,
+                             MESSAGE_RECEPTOR_SLEEP_MS, NULL},
+    [PERF_INPUT_PRIO] = {"input_prio", "prio", "live",
+                         K_HIGHEST_APPLICATION_THREAD_PRIO,
+                         K_LOWEST_APPLICATION_THREAD_PRIO,
+                         MESSAGE_RECEPTOR_PRIO, perf_params_apply_prio},
+    [PERF_INPUT_STACK] = {"input_stack", "bytes", "reboot", 512,
+                          MESSAGE_RECEPTOR_STACK_MAX,
+                          MESSAGE_RECEPTOR_STACK_SIZE, NULL},
+    [PERF_NOTIFY_DEPTH] = {"notify_depth", "msgs", "live", 1,
+                           NOTIFY_FANOUT_MAX_DEPTH, NOTIFY_FANOUT_MAX_DEPTH,
+                           perf_params_apply_depth},
+    [PERF_CONTROL_DEPTH] = {"control_depth", "msgs", "live", 1,
+                            OUTBOUND_QOS_BUF_COUNT, OUTBOUND_QOS_BUF_COUNT,
+                            perf_params_apply_depth},
+    [PERF_BULK_DEPTH] = {"bulk_depth", "msgs", "live", 1,
+                         OUTBOUND_QOS_BUF_COUNT, OUTBOUND_QOS_BUF_COUNT,
+                         perf_params_apply_depth},
+};
+
+/**
+ * @brief Estrutura interna de variáveis.
+ *
+ */
+static struct {
+  int32_t values[PERF_PARAMS]; /* Valores atuais. */
+  struct k_mutex lock;         /* Serializa alterações e leituras. */
+} self;
+
+static void perf_params_apply_depth(enum perf_param param) {
+  switch (param) {
+  case PERF_NOTIFY_DEPTH:
+    notify_fanout_set_depth(self.values[param]);
+    break;
+  case PERF_CONTROL_DEPTH:
+    outbound_qos_set_depth(OUTBOUND_QOS_CONTROL, self.values[param]);
+    break;
+  case PERF_BULK_DEPTH:
+    outbound_qos_set_depth(OUTBOUND_QOS_BULK, self.values[param]);
+    break;
+  default:
+    break;
+  }
+}
+
+static void perf_params_apply_scan(enum perf_param param) {
+  ARG_UNUSED(param);
+
+  scan_sched_kick();
+}
+
+static void perf_params_apply_conn(enum perf_param param) {
+  ARG_UNUSED(param);
+
+  ble_central_update_conn_params();
+}
+
+static void perf_params_apply_prio(enum perf_param param) {
+  ARG_UNUSED(param);
+
+  message_receptor_update_priority();
+}
+
+static bool perf_params_consistent(const int32_t *values) {
+  /* Timeout de supervisão maior que (1 + latência) * intervalo * 2. */
+  return values[PERF_SCAN_WINDOW] <= values[PERF_SCAN_INTERVAL] &&
+         values[PERF_CONN_INTERVAL_MIN] <= values[PERF_CONN_INTERVAL_MAX] &&
+         values[PERF_CONN_TIMEOUT] * 4 >
+             (1 + values[PERF_CONN_LATENCY]) * values[PERF_CONN_INTERVAL_MAX];
+}
+
+static enum perf_param perf_params_find(const char *name) {
+  for (int i = 0; i < PERF_PARAMS; i++) {
+    if (strcmp(name, perf_params_desc[i].name) == 0) {
+      return i;
+    }
+  }
+
+  return PERF_PARAMS;
+}
+
+#if defined(CONFIG_SETTINGS)
+/**
+ * @brief Recebe cada valor persistido em "perf/<nome>" durante o
+ * carregamento.
+ *
+ * @param name [in] Chave sem o prefixo "perf/".
+ * @param len Tamanho do valor.
+ * @param read_cb Função de leitura do valor.
+ * @param cb_arg Argumento de read_cb.
+ * @return int 0 para sucesso e um inteiro negativo em caso de falha.
+ */
+static int perf_params_settings_set(const char *name, size_t len,
+                                    settings_read_cb read_cb, void *cb_arg) {
+  enum perf_param param = perf_params_find(name);
+  int32_t value;
+
+  /* Chaves de versões anteriores são ignoradas. */
+  if (param == PERF_PARAMS) {
+    return 0;
+  }
+
+  if (len != sizeof(value) || read_cb(cb_arg, &value, len) != (ssize_t)len) {
+    return -EINVAL;
+  }
+
+  if (value >= perf_params_desc[param].min &&
+      value <= perf_params_desc[param].max) {
+    self.values[param] = value;
+  }
+
+  return 0;
+}
+
+SETTINGS_STATIC_HANDLER_DEFINE(perf, "perf", NULL, perf_params_settings_set,
+                               NULL, NULL);
+
+/**
+ * @brief Persiste um valor em "perf/<nome>".
+ *
+ * @param param Parâmetro persistido.
+ * @return int 0 para sucesso e um inteiro negativo em caso de falha.
+ */
+static int perf_params_save(enum perf_param param) {
+  char key[32];
+
+  snprintk(key, sizeof(key), "perf/%s", perf_params_desc[param].name);
+  return settings_save_one(key, &self.values[param], sizeof(int32_t));
+}
+
+/**
+ * @brief Apaga um valor persistido, voltando ao padrão no próximo boot.
+ *
+ * @param param Parâmetro apagado.
+ * @return int 0 para sucesso e um inteiro negativo em caso de falha.
+ */
+static int perf_params_erase(enum perf_param param) {
+  char key[32];
+
+  snprintk(key, sizeof(key), "perf/%s", perf_params_desc[param].name);
+  return settings_delete(key);
+}
+#else
+static int perf_params_save(enum perf_param param) { return 0; }
+static int perf_params_erase(enum perf_param param) { return 0; }
+#endif
+
+int perf_params_init(void) {
+  int err = 0;
+
+  k_mutex_init(&self.lock);
+
+  for (int i = 0; i < PERF_PARAMS; i++) {
+    self.values[i] = perf_params_desc[i].def;
+  }
+
+#if defined(CONFIG_SETTINGS)
+  err = settings_subsys_init();
+  if (!err) {
+    err = settings_load_subtree("perf");
+  }
+  if (err) {
+    printk("|PERF| Settings load failed (err %d), using defaults.\n", err);
+  }
+#endif
+
+  /* Valores válidos um a um podem não ser válidos juntos. */
+  if (!perf_params_consistent(self.values)) {
+    printk("|PERF| Stored values are inconsistent, using defaults.\n");
+    for (int i = 0; i < PERF_PARAMS; i++) {
+      self.values[i] = perf_params_desc[i].def;
+    }
+  }
+
+  perf_params_apply_depth(PERF_NOTIFY_DEPTH);
+  perf_params_apply_depth(PERF_CONTROL_DEPTH);
+  perf_params_apply_depth(PERF_BULK_DEPTH);
+
+  return err;
+}
+
+int32_t perf_params_get(enum perf_param param) {
+  return self.values[param];
+}
+
+int perf_params_set(enum perf_param param, int32_t value) {
+  const struct perf_param_desc *desc = &perf_params_desc[param];
+  int32_t values[PERF_PARAMS];
+  int err;
+
+  if (value < desc->min || value > desc->max) {
+    return -EINVAL;
+  }
+
+  k_mutex_lock(&self.lock, K_FOREVER);
+
+  memcpy(values, self.values, sizeof(values));
+  values[param] = value;
+  if (!perf_params_consistent(values)) {
+    k_mutex_unlock(&self.lock);
+    return -EINVAL;
+  }
+
+  self.values[param] = value;
+  err = perf_params_save(param);
+
+  k_mutex_unlock(&self.lock);
+
+  if (desc->apply) {
+    desc->apply(param);
+  }
+
+  return err;
+}
+
+void perf_params_dump(void) {
+  const struct perf_param_desc *desc;
+
+  for (int i = 0; i < PERF_PARAMS; i++) {
+    desc = &perf_params_desc[i];
+    printk("|PERF| %s=%d %s (default %d, %d..%d, applied %s).\n", desc->name,
+           self.values[i], desc->unit, desc->def, desc->min, desc->max,
+           desc->applied);
+  }
+}
+
+/**
+ * @brief Volta todos os parâmetros ao padrão e apaga os valores persistidos.
+ *
+ */
+static void perf_params_reset(void) {
+  k_mutex_lock(&self.lock, K_FOREVER);
+  for (int i = 0; i < PERF_PARAMS; i++) {
+    self.values[i] = perf_params_desc[i].def;
+    perf_params_erase(i);
+  }
+  k_mutex_unlock(&self.lock);
+
+  for (int i = 0; i < PERF_PARAMS; i++) {
+    if (perf_params_desc[i].apply) {
+      perf_params_desc[i].apply(i);
+    }
+  }
+}
+
+bool perf_params_command(char *line) {
+  char *save = NULL;
+  char *word;
+  char *name;
+  char *value;
+  char *end;
+  enum perf_param param;
+  long parsed;
+  int err;
+
+  /* Só tokeniza linhas de comando; as demais seguem intactas. */
+  if (strncmp(line, "perf", 4) != 0 || (line[4] != ' ' && line[4] != '\0')) {
+    return false;
+  }
+
+  strtok_r(line, " ", &save);
+  word = strtok_r(NULL, " ", &save);
+
+  if (word != NULL && strcmp(word, "dump") == 0) {
+    perf_params_dump();
+  } else if (word != NULL && strcmp(word, "reset") == 0) {
+    perf_params_reset();
+    printk("|PERF| Defaults restored.\n");
+  } else if (word != NULL && strcmp(word, "stats") == 0) {
+    notify_fanout_print_stats();
+    outbound_qos_print_stats();
+    scan_sched_print_stats();
+    time_sync_print_stats();
+  } else if (word != NULL && strcmp(word, "set") == 0) {
+    name = strtok_r(NULL, " ", &save);
+    value = strtok_r(NULL, " ", &save);
+    param = name ? perf_params_find(name) : PERF_PARAMS;
+
+    if (param == PERF_PARAMS || value == NULL) {
+      printk("|PERF| Usage: perf set <name> <value>; names in perf dump.\n");
+      return true;
+    }
+
+    parsed = strtol(value, &end, 0);
+    if (*end != '\0') {
+      printk("|PERF| Invalid number: %s.\n", value);
+      return true;
+    }
+
+    err = perf_params_set(param, parsed);
+    if (err == -EINVAL) {
+      printk("|PERF| %s=%ld rejected: out of %d..%d or inconsistent with "
+             "the other values.\n",
+             name, parsed, perf_params_desc[param].min,
+             perf_params_desc[param].max);
+    } else if (err) {
+      printk("|PERF| %s=%ld applied but not saved (err %d).\n", name, parsed,
+             err);
+    } else {
+      printk("|PERF| %s=%ld, applied %s.\n", name, parsed,
+             perf_params_desc[param].applied);
+    }
+  } else {
+    printk("|PERF| Usage: perf dump | perf set <name> <value> | perf reset "
+           "| perf stats.\n");
+  }
+
+  return true;
+}
@@ -0,0 +1,294 @@
+/**
+ * @file scan_sched.c
+ * @brief Implementação do escalonador de escaneamento do Central.
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "scan_sched.h"
+
+#include "ble_central.h"
+
+/**
+ * @brief Escolhe o modo a partir dos links, da ocupação das filas e da
+ * política. Chamada com scan_sched_lock.
+ *
+ * @param now Uptime atual, em milissegundos.
+ * @return enum scan_sched_mode Modo escolhido.
+ */
+static enum scan_sched_mode scan_sched_pick(int64_t now);
+
+/**
+ * @brief Aplica um modo na stack Bluetooth.
+ *
+ * @param mode Modo aplicado.
+ * @return int 0 para sucesso e um inteiro negativo em caso de falha.
+ */
+static int scan_sched_apply(enum scan_sched_mode mode);
+
+/**
+ * @brief Tarefa que reavalia o modo periodicamente e a cada evento.
+ *
+ */
+static void scan_sched_task(void);
+
+/**
+ * @brief Acorda a tarefa antes do fim do período.
+ *
+ */
+K_SEM_DEFINE(scan_sched_sem, 0, 1);
+
+/**
+ * @brief Protege o estado dos links e os contadores.
+ *
+ */
+K_MUTEX_DEFINE(scan_sched_lock);
+
+/**
+ * @brief Define a tarefa do escalonador, abaixo do escalonador de saída.
+ *
+ */
+K_THREAD_DEFINE(scan_sched, 1024, scan_sched_task, NULL, NULL, NULL, 3, 0, 0);
+
+/**
+ * @brief Nomes dos modos, na ordem de enum scan_sched_mode.
+ *
+ */
+static const char *const scan_sched_names[SCAN_SCHED_MODES] = {
+    "off", "boost", "fast", "slow", "passive", "paused",
+};
+
+/**
+ * @brief Estrutura interna de variáveis.
+ *
+ */
+static struct {
+  bool ready;                    /* Stack Bluetooth pronta. */
+  bool connecting;               /* Escaneamento parado por uma conexão. */
+  bool dirty;                    /* Reaplicar o modo atual. */
+  uint32_t links;                /* Links estabelecidos. */
+  enum scan_sched_mode mode;     /* Modo aplicado. */
+  int64_t since_ms;              /* Uptime da última troca de modo. */
+  int64_t boost_until_ms;        /* Fim do modo contínuo. */
+  int64_t hold_until_ms;         /* Fim da pausa após uma rajada. */
+  int64_t search_ms;             /* Início da busca sem link, ou 0. */
+  struct scan_sched_stats stats; /* Contadores do escalonador. */
+} self = {
+    .ready = false,
+    .connecting = false,
+    .dirty = false,
+    .links = 0,
+    .mode = SCAN_SCHED_OFF,
+};
+
+static enum scan_sched_mode scan_sched_pick(int64_t now) {
+  int32_t policy = perf_params_get(PERF_SCAN_POLICY);
+  uint32_t fill;
+
+  if (!self.ready || self.connecting) {
+    return SCAN_SCHED_OFF;
+  }
+
+  if (self.links == 0) {
+    return (policy == SCAN_SCHED_POLICY_ADAPTIVE && now < self.boost_until_ms)
+               ? SCAN_SCHED_BOOST
+               : SCAN_SCHED_FAST;
+  }
+
+  if (policy == SCAN_SCHED_POLICY_LEGACY) {
+    return SCAN_SCHED_OFF;
+  }
+  if (policy == SCAN_SCHED_POLICY_FIXED) {
+    return SCAN_SCHED_FAST;
+  }
+
+  /* Rajada: o rádio fica com os eventos de conexão até a fila esvaziar. */
+  fill = outbound_qos_fill();
+  if (fill >= SCAN_SCHED_BURST_FILL) {
+    self.hold_until_ms = now + SCAN_SCHED_HOLD_MS;
+    return SCAN_SCHED_PAUSED;
+  }
+  if (now < self.hold_until_ms) {
+    return SCAN_SCHED_PAUSED;
+  }
+
+  /* Com dados na fila, sem SCAN_REQ: o rádio só escuta. */
+  return fill > 0 ? SCAN_SCHED_PASSIVE : SCAN_SCHED_SLOW;
+}
+
+static int scan_sched_apply(enum scan_sched_mode mode) {
+  struct bt_le_scan_param param = {
+      .type = BT_LE_SCAN_TYPE_ACTIVE,
+      .options = BT_LE_SCAN_OPT_NONE,
+      .interval = perf_params_get(PERF_SCAN_INTERVAL),
+      .window = perf_params_get(PERF_SCAN_WINDOW),
+  };
+
+  switch (mode) {
+  case SCAN_SCHED_BOOST:
+    param.window = param.interval;
+    break;
+  case SCAN_SCHED_FAST:
+    break;
+  case SCAN_SCHED_PASSIVE:
+    param.type = BT_LE_SCAN_TYPE_PASSIVE;
+    /* fall through */
+  case SCAN_SCHED_SLOW:
+    param.interval = BT_GAP_SCAN_SLOW_INTERVAL_1;
+    param.window = BT_GAP_SCAN_SLOW_WINDOW_1;
+    break;
+  default:
+    return ble_central_scan(NULL);
+  }
+
+  return ble_central_scan(&param);
+}
+
+static void scan_sched_task(void) {
+  enum scan_sched_mode mode;
+  int64_t now;
+
+  while (true) {
+    k_sem_take(&scan_sched_sem, K_MSEC(SCAN_SCHED_PERIOD_MS));
+
+    /* Aplicado sob a trava: uma conexão não começa no meio da troca. */
+    k_mutex_lock(&scan_sched_lock, K_FOREVER);
+    now = k_uptime_get();
+    mode = scan_sched_pick(now);
+
+    if (mode != self.mode || self.dirty) {
+      if (scan_sched_apply(mode)) {
+        self.stats.errors++;
+        self.dirty = true;
+      } else {
+        self.stats.residency_ms[self.mode] += now - self.since_ms;
+        self.since_ms = now;
+        self.stats.switches += (mode != self.mode);
+        self.mode = mode;
+        self.dirty = false;
+      }
+    }
+    k_mutex_unlock(&scan_sched_lock);
+  }
+}
+
+/**
+ * @brief Inicia uma busca sem link: modo contínuo e medição da espera até o
+ * achado. Chamada com scan_sched_lock.
+ *
+ */
+static void scan_sched_search(void) {
+  self.search_ms = k_uptime_get();
+  self.boost_until_ms = self.search_ms + SCAN_SCHED_BOOST_MS;
+}
+
+void scan_sched_start(void) {
+  k_mutex_lock(&scan_sched_lock, K_FOREVER);
+  self.ready = true;
+  self.since_ms = k_uptime_get();
+  scan_sched_search();
+  k_mutex_unlock(&scan_sched_lock);
+
+  k_sem_give(&scan_sched_sem);
+}
+
+void scan_sched_kick(void) {
+  k_mutex_lock(&scan_sched_lock, K_FOREVER);
+  self.dirty = true;
+  k_mutex_unlock(&scan_sched_lock);
+
+  k_sem_give(&scan_sched_sem);
+}
+
+void scan_sched_on_match(void) {
+  uint32_t waited;
+
+  k_mutex_lock(&scan_sched_lock, K_FOREVER);
+  if (self.links > 0) {
+    self.stats.background++;
+  } else if (self.search_ms != 0) {
+    waited = k_uptime_get() - self.search_ms;
+    self.search_ms = 0;
+
+    self.stats.discoveries++;
+    self.stats.discovery_last_ms = waited;
+    self.stats.discovery_sum_ms += waited;
+    if (waited > self.stats.discovery_max_ms) {
+      self.stats.discovery_max_ms = waited;
+    }
+  }
+  k_mutex_unlock(&scan_sched_lock);
+}
+
+void scan_sched_connecting(void) {
+  k_mutex_lock(&scan_sched_lock, K_FOREVER);
+  self.connecting = true;
+  k_mutex_unlock(&scan_sched_lock);
+}
+
+void scan_sched_connect_failed(void) {
+  k_mutex_lock(&scan_sched_lock, K_FOREVER);
+  self.connecting = false;
+  scan_sched_search();
+  self.dirty = true;
+  k_mutex_unlock(&scan_sched_lock);
+
+  k_sem_give(&scan_sched_sem);
+}
+
+void scan_sched_link_up(void) {
+  k_mutex_lock(&scan_sched_lock, K_FOREVER);
+  self.connecting = false;
+  self.links++;
+  /* O escaneamento parou na criação da conexão. */
+  self.dirty = true;
+  k_mutex_unlock(&scan_sched_lock);
+
+  k_sem_give(&scan_sched_sem);
+}
+
+void scan_sched_link_down(void) {
+  k_mutex_lock(&scan_sched_lock, K_FOREVER);
+  if (self.links > 0) {
+    self.links--;
+  }
+  self.connecting = false;
+  if (self.links == 0) {
+    scan_sched_search();
+  }
+  k_mutex_unlock(&scan_sched_lock);
+
+  k_sem_give(&scan_sched_sem);
+}
+
+void scan_sched_get_stats(struct scan_sched_stats *stats) {
+  k_mutex_lock(&scan_sched_lock, K_FOREVER);
+  *stats = self.stats;
+  /* Inclui o tempo corrido no modo atual. */
+  stats->residency_ms[self.mode] += k_uptime_get() - self.since_ms;
+  k_mutex_unlock(&scan_sched_lock);
+}
+
+void scan_sched_print_stats(void) {
+  struct scan_sched_stats stats;
+
+  scan_sched_get_stats(&stats);
+
+  printk("|SCAN| mode=%s switches=%u errors=%u discoveries=%u "
+         "discovery_last_ms=%u discovery_avg_ms=%u discovery_max_ms=%u "
+         "background=%u.\n",
+         scan_sched_names[self.mode], stats.switches, stats.errors,
+         stats.discoveries, stats.discovery_last_ms,
+         stats.discoveries
+             ? (uint32_t)(stats.discovery_sum_ms / stats.discoveries)
+             : 0,
+         stats.discovery_max_ms, stats.background);
+
+  for (int i = 0; i < SCAN_SCHED_MODES; i++) {
+    printk("|SCAN| %s_ms=%lld.\n", scan_sched_names[i],
+           stats.residency_ms[i]);
+  }
+}
@@ -0,0 +1,427 @@
+/**
+ * @file time_sync.c
+ * @brief Implementação da sincronização de relógio com o Peripheral e da
+ * medição de latência por sentido.
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "time_sync.h"
+
+/**
+ * @brief Latências de uma escrita ecoada.
+ *
+ */
+struct time_sync_latency {
+  uint16_t seq;     /* Sequência da escrita. */
+  int32_t uplink;   /* Central -> Peripheral. */
+  int32_t proc;     /* Processamento no Peripheral. */
+  int32_t downlink; /* Peripheral -> Central. */
+};
+
+/**
+ * @brief Envia um pedido de sincronização e agenda o próximo.
+ *
+ * @param work [in] Ponteiro para o trabalho agendado.
+ */
+static void time_sync_request(struct k_work *work);
+
+/**
+ * @brief Trata uma resposta: calcula offset e atraso da amostra e, a cada
+ * janela, inclui a de menor atraso no modelo.
+ *
+ * @param data [in] Ponteiro para a resposta.
+ * @param t4 Instante da chegada da resposta.
+ */
+static void time_sync_on_response(const uint8_t *data, uint64_t t4);
+
+/**
+ * @brief Trata um carimbo: separa uplink, processamento e downlink.
+ *
+ * @param data [in] Ponteiro para o carimbo.
+ * @param latency [out] Latências da escrita, para impressão fora do lock.
+ * @return true Se a escrita foi ecoada e a latência deve ser impressa.
+ * @return false Caso contrário.
+ */
+static bool time_sync_on_stamp(const uint8_t *data,
+                               struct time_sync_latency *latency);
+
+/**
+ * @brief Refaz a regressão linear do offset sobre os pontos do modelo.
+ * Chamada com lock.
+ *
+ */
+static void time_sync_fit(void);
+
+/**
+ * @brief Acumula uma amostra de latência.
+ *
+ * @param lat [in] Ponteiro para os contadores.
+ * @param us Amostra, em microssegundos.
+ */
+static void time_sync_lat_add(struct time_sync_lat *lat, int32_t us);
+
+/**
+ * @brief Trabalho dos pedidos periódicos.
+ *
+ */
+K_WORK_DELAYABLE_DEFINE(time_sync_work, time_sync_request);
+
+/**
+ * @brief Protege o modelo e os acompanhamentos. É um mutex, e não um
+ * spinlock, porque a regressão em double é emulada em software e não deve
+ * rodar com interrupções mascaradas.
+ *
+ */
+K_MUTEX_DEFINE(time_sync_lock);
+
+/**
+ * @brief Amostra de uma troca pedido/resposta.
+ *
+ */
+struct time_sync_sample {
+  uint64_t local_us; /* Meio da troca, no relógio do Central. */
+  int64_t offset_us; /* Peripheral menos Central. */
+  int64_t delay_us;  /* Ida e volta sem o processamento do Peripheral. */
+};
+
+/**
+ * @brief Escrita acompanhada.
+ *
+ */
+struct time_sync_write {
+  uint16_t seq;     /* Sequência da escrita desde a conexão. */
+  bool valid;       /* Entrada preenchida. */
+  uint64_t sent_us; /* Instante do envio. */
+};
+
+/**
+ * @brief Estrutura interna de variáveis.
+ *
+ */
+static struct {
+  struct bt_conn *conn;                             /* Conexão sincronizada. */
+  uint16_t handle;                                  /* Característica 0x2BC8. */
+  uint8_t req_seq;                                  /* Próximo pedido. */
+  uint64_t req_t1[8];                               /* Envio, por seq % 8. */
+  uint32_t window_len;                              /* Amostras na janela. */
+  struct time_sync_sample window[TIME_SYNC_WINDOW]; /* Janela atual. */
+  struct time_sync_sample points[TIME_SYNC_POINTS]; /* Pontos do modelo. */
+  uint32_t point_count;                             /* Pontos preenchidos. */
+  uint32_t point_next;                              /* Próximo a reusar. */
+  uint64_t ref_local_us;                            /* Referência. */
+  double ref_offset_us;                             /* Offset na referência. */
+  double drift;                                     /* Deriva, em us/us. */
+  uint16_t write_seq;                               /* Escritas na conexão. */
+  struct time_sync_write writes[TIME_SYNC_TRACKED]; /* Por seq % N. */
+  uint64_t echo_us;                                 /* Último eco. */
+  bool echo_pending;                                /* Eco sem carimbo. */
+  struct time_sync_stats stats;                     /* Contadores. */
+  struct k_work_sync cancel_sync;                   /* Cancelamento. */
+} self;
+
+static void time_sync_lat_add(struct time_sync_lat *lat, int32_t us) {
+  if (lat->count == 0 || us < lat->min_us) {
+    lat->min_us = us;
+  }
+  if (lat->count == 0 || us > lat->max_us) {
+    lat->max_us = us;
+  }
+  lat->count++;
+  lat->sum_us += us;
+}
+
+static void time_sync_request(struct k_work *work) {
+  uint8_t req[ECOUART_SYNC_REQ_LEN];
+  struct bt_conn *conn;
+  uint32_t sent;
+  int err;
+
+  /* A referência mantém a conexão válida até o fim da escrita, mesmo se a
+   * desconexão chegar no meio. */
+  k_mutex_lock(&time_sync_lock, K_FOREVER);
+  if (self.conn == NULL) {
+    k_mutex_unlock(&time_sync_lock);
+    return;
+  }
+  conn = bt_conn_ref(self.conn);
+  req[0] = ECOUART_SYNC_OP_REQ;
+  req[1] = self.req_seq++;
+  sent = self.stats.requests++;
+  self.req_t1[req[1] % ARRAY_SIZE(self.req_t1)] = ecouart_clock_us();
+  k_mutex_unlock(&time_sync_lock);
+
+  err = bt_gatt_write_without_response(conn, self.handle, req, sizeof(req),
+                                       false);
+  bt_conn_unref(conn);
+  if (err) {
+    printk("|SYNC| Request failed (err %d).\n", err);
+  }
+
+  k_work_schedule(k_work_delayable_from_work(work),
+                  K_MSEC(sent < TIME_SYNC_FAST_REQUESTS
+                             ? TIME_SYNC_FAST_PERIOD_MS
+                             : TIME_SYNC_PERIOD_MS));
+}
+
+static void time_sync_fit(void) {
+  double mean_x = 0;
+  double mean_y = 0;
+  double sxx = 0;
+  double sxy = 0;
+  double dx;
+  uint64_t base = self.points[0].local_us;
+  uint32_t n = self.point_count;
+
+  /* Abscissas relativas ao primeiro ponto, para não perder precisão. */
+  for (uint32_t i = 0; i < n; i++) {
+    mean_x += (double)(int64_t)(self.points[i].local_us - base);
+    mean_y += (double)self.points[i].offset_us;
+  }
+  mean_x /= n;
+  mean_y /= n;
+
+  for (uint32_t i = 0; i < n; i++) {
+    dx = (double)(int64_t)(self.points[i].local_us - base) - mean_x;
+    sxx += dx * dx;
+    sxy += dx * ((double)self.points[i].offset_us - mean_y);
+  }
+
+  self.ref_local_us = base + (int64_t)mean_x;
+  self.ref_offset_us = mean_y;
+  self.drift = sxx > 0 ? sxy / sxx : 0;
+}
+
+static void time_sync_on_response(const uint8_t *data, uint64_t t4) {
+  uint64_t t1 = self.req_t1[data[1] % ARRAY_SIZE(self.req_t1)];
+  uint64_t t2 = sys_get_le64(&data[2]);
+  uint64_t t3 = sys_get_le64(&data[10]);
+  struct time_sync_sample sample;
+  struct time_sync_sample *best;
+
+  sample.local_us = t1 + (t4 - t1) / 2;
+  sample.offset_us = ((int64_t)(t2 - t1) + (int64_t)(t3 - t4)) / 2;
+  sample.delay_us = (int64_t)(t4 - t1) - (int64_t)(t3 - t2);
+
+  /* Resposta a um pedido já sobrescrito ou atraso impossível. */
+  if (sample.delay_us < 0) {
+    return;
+  }
+
+  self.stats.responses++;
+  if (self.stats.min_delay_us == 0 ||
+      sample.delay_us < self.stats.min_delay_us) {
+    self.stats.min_delay_us = sample.delay_us;
+  }
+
+  self.window[self.window_len++] = sample;
+  if (self.window_len < TIME_SYNC_WINDOW) {
+    return;
+  }
+
+  /* Atrasos maiores vêm de eventos de conexão perdidos ou de fila, que
+   * tornam a troca assimétrica; a amostra mais rápida é a mais fiel. */
+  best = &self.window[0];
+  for (int i = 1; i < TIME_SYNC_WINDOW; i++) {
+    if (self.window[i].delay_us < best->delay_us) {
+      best = &self.window[i];
+    }
+  }
+  self.window_len = 0;
+
+  self.points[self.point_next] = *best;
+  self.point_next = (self.point_next + 1) % TIME_SYNC_POINTS;
+  self.point_count = MIN(self.point_count + 1, TIME_SYNC_POINTS);
+  self.stats.points++;
+
+  time_sync_fit();
+}
+
+/**
+ * @brief Converte um instante do Peripheral sem tomar o lock.
+ *
+ * @param peer_us Instante no relógio do Peripheral.
+ * @return uint64_t Instante no relógio do Central.
+ */
+static uint64_t time_sync_to_local_locked(uint64_t peer_us) {
+  /* O offset varia com a deriva; o instante local é aproximado pelo offset
+   * da referência, erro desprezível para derivas de ppm. */
+  uint64_t approx = peer_us - (int64_t)self.ref_offset_us;
+  double offset = self.ref_offset_us +
+                  self.drift * (double)(int64_t)(approx - self.ref_local_us);
+
+  return peer_us - (int64_t)offset;
+}
+
+static bool time_sync_on_stamp(const uint8_t *data,
+                               struct time_sync_latency *latency) {
+  uint8_t flags = data[1];
+  uint16_t seq = sys_get_le16(&data[2]);
+  uint64_t t_rx = sys_get_le64(&data[4]);
+  uint64_t t_tx = sys_get_le64(&data[12]);
+  struct time_sync_write *write = &self.writes[seq % TIME_SYNC_TRACKED];
+  bool echoed = (flags & ECOUART_SYNC_STAMP_ECHOED) && self.echo_pending;
+
+  self.stats.stamps++;
+
+  /* O eco chega antes do seu carimbo e depois do carimbo anterior. */
+  if (flags & ECOUART_SYNC_STAMP_ECHOED) {
+    self.echo_pending = false;
+  }
+
+  if (!write->valid || write->seq != seq || self.point_count == 0) {
+    self.stats.unmatched++;
+    return false;
+  }
+  write->valid = false;
+
+  latency->seq = seq;
+  latency->uplink =
+      (int32_t)(time_sync_to_local_locked(t_rx) - write->sent_us);
+  latency->proc = (int32_t)(t_tx - t_rx);
+  time_sync_lat_add(&self.stats.uplink, latency->uplink);
+  time_sync_lat_add(&self.stats.proc, latency->proc);
+
+  if (echoed) {
+    latency->downlink =
+        (int32_t)(self.echo_us - time_sync_to_local_locked(t_tx));
+    time_sync_lat_add(&self.stats.downlink, latency->downlink);
+  }
+
+  return echoed;
+}
+
+void time_sync_start(struct bt_conn *conn, uint16_t handle) {
+  struct bt_conn *old;
+
+  k_mutex_lock(&time_sync_lock, K_FOREVER);
+
+  /* Modelo e acompanhamentos valem apenas para esta conexão. */
+  memset(&self.stats, 0, sizeof(self.stats));
+  memset(self.writes, 0, sizeof(self.writes));
+  self.window_len = 0;
+  self.point_count = 0;
+  self.point_next = 0;
+  self.drift = 0;
+  self.echo_pending = false;
+  old = self.conn;
+  self.conn = bt_conn_ref(conn);
+  self.handle = handle;
+  k_mutex_unlock(&time_sync_lock);
+
+  if (old != NULL) {
+    bt_conn_unref(old);
+  }
+
+  printk("|SYNC| Started, clock resolution %u ns.\n",
+         ecouart_clock_resolution_ns());
+  k_work_schedule(&time_sync_work, K_NO_WAIT);
+}
+
+void time_sync_stop(void) {
+  struct bt_conn *conn;
+
+  k_mutex_lock(&time_sync_lock, K_FOREVER);
+  conn = self.conn;
+  self.conn = NULL;
+  self.write_seq = 0;
+  k_mutex_unlock(&time_sync_lock);
+
+  /* Espera um pedido em andamento terminar antes de soltar a conexão. */
+  k_work_cancel_delayable_sync(&time_sync_work, &self.cancel_sync);
+  if (conn != NULL) {
+    bt_conn_unref(conn);
+  }
+}
+
+void time_sync_on_write(void) {
+  uint64_t now = ecouart_clock_us();
+  struct time_sync_write *write;
+  uint16_t seq;
+
+  k_mutex_lock(&time_sync_lock, K_FOREVER);
+  seq = self.write_seq++;
+  write = &self.writes[seq % TIME_SYNC_TRACKED];
+  write->seq = seq;
+  write->valid = true;
+  write->sent_us = now;
+  k_mutex_unlock(&time_sync_lock);
+}
+
+void time_sync_on_echo(void) {
+  uint64_t now = ecouart_clock_us();
+
+  k_mutex_lock(&time_sync_lock, K_FOREVER);
+  self.echo_us = now;
+  self.echo_pending = true;
+  k_mutex_unlock(&time_sync_lock);
+}
+
+void time_sync_on_notify(const uint8_t *data, uint16_t len) {
+  uint64_t now = ecouart_clock_us();
+  struct time_sync_latency latency;
+  bool echoed = false;
+
+  k_mutex_lock(&time_sync_lock, K_FOREVER);
+  if (len == ECOUART_SYNC_RSP_LEN && data[0] == ECOUART_SYNC_OP_RSP) {
+    time_sync_on_response(data, now);
+  } else if (len == ECOUART_SYNC_STAMP_LEN &&
+             data[0] == ECOUART_SYNC_OP_STAMP) {
+    echoed = time_sync_on_stamp(data, &latency);
+  }
+  k_mutex_unlock(&time_sync_lock);
+
+  /* Impressão fora do lock, para não segurar quem escreve. */
+  if (echoed) {
+    printk("|LATENCY| seq=%u uplink_us=%d proc_us=%d downlink_us=%d.\n",
+           latency.seq, latency.uplink, latency.proc, latency.downlink);
+  }
+}
+
+bool time_sync_is_locked(void) { return self.point_count > 0; }
+
+uint64_t time_sync_to_local(uint64_t peer_us) {
+  uint64_t local;
+
+  k_mutex_lock(&time_sync_lock, K_FOREVER);
+  local = time_sync_to_local_locked(peer_us);
+  k_mutex_unlock(&time_sync_lock);
+
+  return local;
+}
+
+/**
+ * @brief Imprime os contadores de um sentido.
+ *
+ * @param name [in] Nome do sentido.
+ * @param lat [in] Ponteiro para os contadores.
+ */
+static void time_sync_print_lat(const char *name,
+                                const struct time_sync_lat *lat) {
+  printk("|SYNC| %s count=%u avg_us=%d min_us=%d max_us=%d.\n", name,
+         lat->count, lat->count ? (int32_t)(lat->sum_us / lat->count) : 0,
+         lat->min_us, lat->max_us);
+}
+
+void time_sync_print_stats(void) {
+  struct time_sync_stats stats;
+  int64_t offset_us;
+  int32_t drift_ppb;
+
+  k_mutex_lock(&time_sync_lock, K_FOREVER);
+  offset_us = (int64_t)self.ref_offset_us;
+  drift_ppb = (int32_t)(self.drift * 1e9);
+  stats = self.stats;
+  k_mutex_unlock(&time_sync_lock);
+
+  printk("|SYNC| offset_us=%lld drift_ppb=%d points=%u requests=%u "
+         "responses=%u min_rtt_us=%u stamps=%u unmatched=%u.\n",
+         offset_us, drift_ppb, stats.points, stats.requests, stats.responses,
+         stats.min_delay_us, stats.stamps, stats.unmatched);
+  time_sync_print_lat("uplink", &stats.uplink);
+  time_sync_print_lat("proc", &stats.proc);
+  time_sync_print_lat("downlink", &stats.downlink);
+}
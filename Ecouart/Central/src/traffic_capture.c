@@ -0,0 +1,90 @@
+/**
+ * @file traffic_capture.c
+ * @brief Implementação da captura de tráfego do Central.
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "traffic_capture.h"
+
+#if defined(ECOUART_CAPTURE)
+#include "notify_fanout.h"
+
+/**
+ * @brief Captura as notificações a partir da distribuição, fora do callback
+ * de RX do Bluetooth, usando o instante da publicação.
+ *
+ * @param sub [in] Ponteiro para o assinante.
+ * @param buf [in] Buffer compartilhado com o payload.
+ */
+static void traffic_capture_notify(struct notify_fanout_sub *sub,
+                                   struct net_buf *buf);
+
+/**
+ * @brief Profundidade da fila de captura: a cota do pool de notify_fanout
+ * com os três assinantes do build de captura (console ou ponte,
+ * estatísticas e captura). Uma fila maior não seria usada e, antes da cota,
+ * deixava a captura segurar o pool inteiro e distorcer o tráfego gravado.
+ *
+ */
+#define TRAFFIC_CAPTURE_DEPTH ((NOTIFY_FANOUT_BUF_COUNT - 1) / 3 - 1)
+
+/**
+ * @brief Perder eventos distorce a reprodução; a fila descarta os mais novos
+ * e a perda aparece nas estatísticas do assinante. As linhas longas rodam
+ * abaixo de todos os outros assinantes.
+ *
+ */
+NOTIFY_FANOUT_SUBSCRIBER_DEFINE(capture_sink, traffic_capture_notify,
+                                TRAFFIC_CAPTURE_DEPTH,
+                                NOTIFY_FANOUT_DROP_NEWEST, 7);
+
+/**
+ * @brief Serializa as linhas CAP: de threads diferentes.
+ *
+ */
+K_MUTEX_DEFINE(capture_lock);
+
+/**
+ * @brief Linha CAP: em montagem.
+ *
+ */
+static char capture_line[24 + 2 * TRAFFIC_CAPTURE_PAYLOAD_MAX];
+
+static void traffic_capture_notify(struct notify_fanout_sub *sub,
+                                   struct net_buf *buf) {
+  ARG_UNUSED(sub);
+
+  traffic_capture_record(TRAFFIC_CAPTURE_NOTIFY,
+                         *(uint32_t *)net_buf_user_data(buf), buf->data,
+                         buf->len);
+}
+
+void traffic_capture_record(enum traffic_capture_event event, uint32_t cycles,
+                            const void *data, uint16_t len) {
+  static const char hex[] = "0123456789abcdef";
+  const uint8_t *bytes = data;
+  size_t pos;
+
+  len = MIN(len, TRAFFIC_CAPTURE_PAYLOAD_MAX);
+
+  k_mutex_lock(&capture_lock, K_FOREVER);
+
+  /* Instante em 32 bits; ecap.py desfaz a volta a cada ~71 minutos. */
+  pos = snprintk(capture_line, sizeof(capture_line), "CAP:%c %u ", (char)event,
+                 (uint32_t)k_cyc_to_us_floor64(cycles));
+  for (uint16_t i = 0; i < len; i++) {
+    capture_line[pos++] = hex[bytes[i] >> 4];
+    capture_line[pos++] = hex[bytes[i] & 0x0f];
+  }
+  capture_line[pos] = '\0';
+
+  /* Uma única chamada por linha, para o console não intercalar eventos. */
+  printk("%s\n", capture_line);
+
+  k_mutex_unlock(&capture_lock);
+}
+#endif
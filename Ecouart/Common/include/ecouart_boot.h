@@ -0,0 +1,53 @@
+/**
+ * @file ecouart_boot.h
+ * @brief Interface das marcas de tempo da inicialização do Ecouart, do reset
+ * até o primeiro byte de dados. A primeira ocorrência de cada etapa é
+ * registrada; ao chegar o primeiro dado o relatório é impresso em uma linha
+ * |BOOT|, lida por Script/boot/boot_report.py.
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef ECOUART_BOOT_H_
+#define ECOUART_BOOT_H_
+
+#include <init.h>
+#include <sys/printk.h>
+#include <zephyr.h>
+
+#include "stdint.h"
+
+/**
+ * @brief Etapas da inicialização. O reset é a origem do uptime.
+ *
+ */
+enum ecouart_boot_stage {
+  ECOUART_BOOT_KERNEL = 0,     /* Kernel iniciado (SYS_INIT POST_KERNEL). */
+  ECOUART_BOOT_MAIN = 1,       /* Entrada de main(). */
+  ECOUART_BOOT_BT_READY = 2,   /* Callback de bt_enable. */
+  ECOUART_BOOT_LINK_START = 3, /* Primeiro advertising ou escaneamento. */
+  ECOUART_BOOT_CONNECTED = 4,  /* Primeira conexão. */
+  ECOUART_BOOT_FIRST_DATA = 5, /* Primeiro byte de dados. */
+  ECOUART_BOOT_STAGES,
+};
+
+/**
+ * @brief Registra a primeira ocorrência de uma etapa. Ao registrar
+ * ECOUART_BOOT_FIRST_DATA, imprime o relatório.
+ *
+ * @param stage Etapa alcançada.
+ */
+void ecouart_boot_mark(enum ecouart_boot_stage stage);
+
+/**
+ * @brief Imprime o relatório com as etapas já alcançadas, em microssegundos
+ * desde o reset (0 para etapas não alcançadas). O nó é identificado por
+ * CONFIG_BT_DEVICE_NAME.
+ *
+ */
+void ecouart_boot_print(void);
+
+#endif /* ECOUART_BOOT_H_ */
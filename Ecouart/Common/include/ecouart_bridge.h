@@ -0,0 +1,131 @@
+/**
+ * @file ecouart_bridge.h
+ * @brief Interface da ponte serial transparente do Ecouart. Com a UART
+ * escolhida em ecouart,bridge-uart e CONFIG_UART_ASYNC_API, os bytes
+ * recebidos pela UART são entregues em blocos do tamanho da MTU e os dados
+ * vindos do BLE saem pela UART por DMA, a partir de um ring buffer.
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef ECOUART_BRIDGE_H_
+#define ECOUART_BRIDGE_H_
+
+#include <devicetree.h>
+#include <zephyr.h>
+
+#include "stddef.h"
+#include "stdint.h"
+
+/**
+ * @brief Indica se a ponte faz parte do build (ambiente nrf52840_dk_bridge).
+ *
+ */
+#if DT_HAS_CHOSEN(ecouart_bridge_uart) && defined(CONFIG_UART_ASYNC_API)
+#define ECOUART_BRIDGE_ENABLED 1
+#else
+#define ECOUART_BRIDGE_ENABLED 0
+#endif
+
+/**
+ * @brief Tamanho do ring buffer de saída para a UART, em bytes.
+ *
+ */
+#define ECOUART_BRIDGE_TX_RING_SIZE 2048
+
+/**
+ * @brief Tamanho do ring buffer de entrada vinda da UART, em bytes.
+ *
+ */
+#define ECOUART_BRIDGE_RX_RING_SIZE 2048
+
+/**
+ * @brief Tamanho de cada um dos dois buffers de DMA de recepção, em bytes.
+ *
+ */
+#define ECOUART_BRIDGE_RX_DMA_SIZE 128
+
+/**
+ * @brief Tempo ocioso na linha, em microssegundos, que encerra um bloco de
+ * recepção incompleto.
+ *
+ */
+#define ECOUART_BRIDGE_RX_TIMEOUT_US 500
+
+/**
+ * @brief Maior bloco entregue ao BLE (MTU de 247 menos o cabeçalho ATT).
+ *
+ */
+#define ECOUART_BRIDGE_CHUNK_MAX 244
+
+/**
+ * @brief Bloco entregue ao BLE antes da troca de MTU (MTU padrão de 23).
+ *
+ */
+#define ECOUART_BRIDGE_CHUNK_DEFAULT 20
+
+/**
+ * @brief Callback que recebe um bloco lido da UART.
+ *
+ * @param data [in] Ponteiro para os dados lidos.
+ * @param len Tamanho dos dados lidos.
+ * @return int 0 se o bloco foi enviado, -ENOMEM/-EAGAIN para tentar de novo
+ * e outro inteiro negativo para descartá-lo.
+ */
+typedef int (*ecouart_bridge_rx_cb_t)(const uint8_t *data, size_t len);
+
+/**
+ * @brief Contadores da ponte.
+ *
+ */
+struct ecouart_bridge_stats {
+  uint32_t tx_bytes;    /* Bytes escritos na UART. */
+  uint32_t tx_dropped;  /* Bytes descartados por ring de saída cheio. */
+  uint32_t rx_bytes;    /* Bytes lidos da UART. */
+  uint32_t rx_dropped;  /* Bytes descartados por ring cheio ou sem link. */
+  uint32_t rx_chunks;   /* Blocos entregues ao BLE. */
+  uint32_t uart_errors; /* Recepções interrompidas por erro de linha. */
+};
+
+/**
+ * @brief Inicializa a UART da ponte e começa a recepção por DMA.
+ *
+ * @param rx_cb Callback chamado na thread da ponte para cada bloco lido.
+ * @return int 0 para sucesso e um inteiro negativo em caso de falha.
+ */
+int ecouart_bridge_init(ecouart_bridge_rx_cb_t rx_cb);
+
+/**
+ * @brief Enfileira dados para saída pela UART sem bloquear.
+ *
+ * @param data [in] Ponteiro para os dados.
+ * @param len Tamanho dos dados.
+ * @return size_t Quantidade de bytes aceitos; o restante é descartado.
+ */
+size_t ecouart_bridge_write(const uint8_t *data, size_t len);
+
+/**
+ * @brief Ajusta o tamanho dos blocos entregues ao BLE após troca de MTU.
+ *
+ * @param chunk Tamanho do bloco, limitado a ECOUART_BRIDGE_CHUNK_MAX.
+ */
+void ecouart_bridge_set_chunk(size_t chunk);
+
+/**
+ * @brief Copia os contadores da ponte.
+ *
+ * @param stats [out] Ponteiro para estrutura que recebe os contadores.
+ */
+void ecouart_bridge_get_stats(struct ecouart_bridge_stats *stats);
+
+/**
+ * @brief Imprime os contadores da ponte no console.
+ *
+ * @param tag Prefixo da linha, como "|BLE CENTRAL|".
+ */
+void ecouart_bridge_print_stats(const char *tag);
+
+#endif /* ECOUART_BRIDGE_H_ */
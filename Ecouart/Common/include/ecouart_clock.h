@@ -0,0 +1,97 @@
+/**
+ * @file ecouart_clock.h
+ * @brief Interface do relógio de microssegundos do Ecouart e do formato das
+ * mensagens da característica de sincronização (0x2BC8). No nRF52 o relógio
+ * usa o TIMER2 pela API de counter (16 MHz, 62.5 ns de resolução), que segue
+ * contando enquanto a CPU dorme em WFI ao custo de manter o HFCLK ligado.
+ * Sem ele (build nativo), cai no contador do kernel, de resolução menor
+ * (RTC1 a 32768 Hz, ~30.5 us); ecouart_clock_resolution_ns informa qual.
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef ECOUART_CLOCK_H_
+#define ECOUART_CLOCK_H_
+
+#include <drivers/counter.h>
+#include <init.h>
+#include <sys/byteorder.h>
+#include <sys/printk.h>
+#include <zephyr.h>
+
+#include "stdint.h"
+
+/**
+ * @brief Indica se o relógio usa o TIMER2 em vez do contador do kernel.
+ *
+ */
+#if defined(CONFIG_COUNTER_TIMER2)
+#define ECOUART_CLOCK_COUNTER 1
+#else
+#define ECOUART_CLOCK_COUNTER 0
+#endif
+
+/**
+ * @brief Pedido de sincronização, do Central: [op][seq].
+ *
+ */
+#define ECOUART_SYNC_OP_REQ 0x01
+
+/**
+ * @brief Resposta do Peripheral: [op][seq][t2 u64][t3 u64], com t2 na
+ * recepção do pedido e t3 no envio da resposta, em us do Peripheral.
+ *
+ */
+#define ECOUART_SYNC_OP_RSP 0x02
+
+/**
+ * @brief Carimbo de uma escrita do Central na característica BLE UART
+ * WRITE: [op][flags][seq u16][t_rx u64][t_tx u64], em us do Peripheral.
+ * seq conta as escritas desde a conexão, a partir de 0.
+ *
+ */
+#define ECOUART_SYNC_OP_STAMP 0x03
+
+/**
+ * @brief Flag do carimbo: a escrita foi ecoada em um notify, enviado em
+ * t_tx.
+ *
+ */
+#define ECOUART_SYNC_STAMP_ECHOED BIT(0)
+
+/**
+ * @brief Tamanho do pedido de sincronização.
+ *
+ */
+#define ECOUART_SYNC_REQ_LEN 2
+
+/**
+ * @brief Tamanho da resposta de sincronização.
+ *
+ */
+#define ECOUART_SYNC_RSP_LEN 18
+
+/**
+ * @brief Tamanho do carimbo; cabe na MTU padrão de 23.
+ *
+ */
+#define ECOUART_SYNC_STAMP_LEN 20
+
+/**
+ * @brief Instante atual do relógio do nó.
+ *
+ * @return uint64_t Microssegundos desde a inicialização do relógio.
+ */
+uint64_t ecouart_clock_us(void);
+
+/**
+ * @brief Resolução do relógio em uso.
+ *
+ * @return uint32_t Nanossegundos por incremento.
+ */
+uint32_t ecouart_clock_resolution_ns(void);
+
+#endif /* ECOUART_CLOCK_H_ */
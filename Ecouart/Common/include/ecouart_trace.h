@@ -0,0 +1,62 @@
+/**
+ * @file ecouart_trace.h
+ * @brief Interface dos marcadores de tracing das etapas do Ecouart. Com
+ * CONFIG_TRACING_CTF os marcadores viram eventos CTF no mesmo fluxo dos
+ * eventos do kernel; sem tracing não geram código.
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef ECOUART_TRACE_H_
+#define ECOUART_TRACE_H_
+
+#include <zephyr.h>
+
+#include "stdint.h"
+
+/**
+ * @brief Id do evento CTF dos marcadores, declarado em
+ * Script/tracing/ecouart.tsdl. Fica acima dos ids usados pelo Zephyr.
+ *
+ */
+#define ECOUART_TRACE_CTF_ID 0xE0
+
+/**
+ * @brief Etapas marcadas no fluxo do Ecouart. Os valores são repetidos no
+ * enum ecouart_stage de Script/tracing/ecouart.tsdl.
+ *
+ */
+enum ecouart_trace_stage {
+  ECOUART_TRACE_SCAN_REPORT = 0,   /* Relatório de advertising recebido. */
+  ECOUART_TRACE_CONNECT = 1,       /* Conexão iniciada pelo Central. */
+  ECOUART_TRACE_CONNECTED = 2,     /* Conexão estabelecida ou falha. */
+  ECOUART_TRACE_DISCOVER_STEP = 3, /* Atributo encontrado na descoberta. */
+  ECOUART_TRACE_SUBSCRIBED = 4,    /* Inscrição no notify concluída. */
+  ECOUART_TRACE_WRITE = 5,         /* Escrita enviada pelo Central. */
+  ECOUART_TRACE_WRITE_RX = 6,      /* Escrita recebida pelo Peripheral. */
+  ECOUART_TRACE_NOTIFY_TX = 7,     /* Notify enviado pelo Peripheral. */
+  ECOUART_TRACE_NOTIFY_RX = 8,     /* Notify recebido pelo Central. */
+  ECOUART_TRACE_ADV_START = 9,     /* Advertising iniciado. */
+  ECOUART_TRACE_DISCONNECTED = 10, /* Conexão encerrada. */
+};
+
+#if defined(CONFIG_TRACING_CTF)
+/**
+ * @brief Emite um marcador CTF.
+ *
+ * @param stage Etapa marcada.
+ * @param arg Argumento da etapa (tamanho, handle, código de erro...).
+ */
+void ecouart_trace_mark(enum ecouart_trace_stage stage, uint32_t arg);
+
+#define ECOUART_TRACE(stage, arg) ecouart_trace_mark((stage), (uint32_t)(arg))
+#else
+#define ECOUART_TRACE(stage, arg)                                              \
+  do {                                                                         \
+  } while (0)
+#endif
+
+#endif /* ECOUART_TRACE_H_ */
@@ -0,0 +1,64 @@
+/**
+ * @file ecouart_boot.c
+ * @brief Implementação das marcas de tempo da inicialização do Ecouart.
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "ecouart_boot.h"
+
+/**
+ * @brief Marca o início do kernel, antes das tarefas da aplicação.
+ *
+ * @param dev Não utilizado.
+ * @return int Sempre 0.
+ */
+static int ecouart_boot_kernel(const struct device *dev);
+
+SYS_INIT(ecouart_boot_kernel, POST_KERNEL, 0);
+
+/**
+ * @brief Estrutura interna de variáveis.
+ *
+ */
+static struct {
+  uint32_t stamp_us[ECOUART_BOOT_STAGES]; /* Uptime de cada etapa. */
+  atomic_t marked;                        /* Bitfield das etapas marcadas. */
+} self = {
+    .marked = ATOMIC_INIT(0),
+};
+
+static int ecouart_boot_kernel(const struct device *dev) {
+  ARG_UNUSED(dev);
+
+  ecouart_boot_mark(ECOUART_BOOT_KERNEL);
+  return 0;
+}
+
+void ecouart_boot_mark(enum ecouart_boot_stage stage) {
+  /* O uptime conta desde o início do timer do sistema, logo após o reset. */
+  uint32_t now_us = (uint32_t)k_ticks_to_us_floor64(k_uptime_ticks());
+
+  if (atomic_test_and_set_bit(&self.marked, stage)) {
+    return;
+  }
+
+  self.stamp_us[stage] = now_us;
+
+  if (stage == ECOUART_BOOT_FIRST_DATA) {
+    ecouart_boot_print();
+  }
+}
+
+void ecouart_boot_print(void) {
+  printk("|BOOT| node=\"%s\" kernel=%u main=%u bt_ready=%u link_start=%u "
+         "connected=%u first_data=%u us.\n",
+         CONFIG_BT_DEVICE_NAME, self.stamp_us[ECOUART_BOOT_KERNEL],
+         self.stamp_us[ECOUART_BOOT_MAIN], self.stamp_us[ECOUART_BOOT_BT_READY],
+         self.stamp_us[ECOUART_BOOT_LINK_START],
+         self.stamp_us[ECOUART_BOOT_CONNECTED],
+         self.stamp_us[ECOUART_BOOT_FIRST_DATA]);
+}
@@ -0,0 +1,249 @@
+/**
+ * @file ecouart_bridge.c
+ * @brief Implementação da ponte serial transparente do Ecouart sobre a API
+ * assíncrona (DMA) da UART.
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "ecouart_bridge.h"
+
+#if ECOUART_BRIDGE_ENABLED
+#include <device.h>
+#include <drivers/uart.h>
+#include <sys/printk.h>
+#include <sys/ring_buffer.h>
+
+/**
+ * @brief Inicia a próxima transmissão por DMA a partir do ring de saída.
+ * Deve ser chamada com o lock da ponte.
+ *
+ */
+static void ecouart_bridge_tx_start(void);
+
+/**
+ * @brief Callback de eventos da API assíncrona da UART.
+ *
+ * @param dev [in] Ponteiro para o device da UART.
+ * @param evt [in] Ponteiro para o evento ocorrido.
+ * @param user_data Não utilizado.
+ */
+static void ecouart_bridge_uart_cb(const struct device *dev,
+                                   struct uart_event *evt, void *user_data);
+
+/**
+ * @brief Tarefa que entrega ao BLE os blocos lidos da UART.
+ *
+ */
+static void ecouart_bridge_task(void);
+
+RING_BUF_DECLARE(bridge_tx_ring, ECOUART_BRIDGE_TX_RING_SIZE);
+RING_BUF_DECLARE(bridge_rx_ring, ECOUART_BRIDGE_RX_RING_SIZE);
+
+/**
+ * @brief Sinaliza dados no ring de entrada.
+ *
+ */
+K_SEM_DEFINE(bridge_rx_sem, 0, 1);
+
+/**
+ * @brief Define a tarefa da ponte. Fica bloqueada até haver dados lidos.
+ *
+ */
+K_THREAD_DEFINE(bridge, 1024, ecouart_bridge_task, NULL, NULL, NULL, 2, 0, 0);
+
+/**
+ * @brief Estrutura interna de variáveis.
+ *
+ */
+static struct {
+  const struct device *uart; /* UART escolhida para a ponte. */
+  struct k_spinlock lock;    /* Protege rings, DMA de TX e contadores. */
+  ecouart_bridge_rx_cb_t rx_cb; /* Destino dos blocos lidos da UART. */
+  size_t chunk;                 /* Tamanho dos blocos entregues ao BLE. */
+  bool tx_busy;                 /* Há uma transmissão por DMA em curso. */
+  uint8_t rx_dma[2][ECOUART_BRIDGE_RX_DMA_SIZE]; /* Buffers de DMA de RX. */
+  uint8_t rx_next;                               /* Próximo buffer de RX. */
+  struct ecouart_bridge_stats stats;             /* Contadores. */
+} self = {
+    .uart = DEVICE_DT_GET(DT_CHOSEN(ecouart_bridge_uart)),
+    .rx_cb = NULL,
+    .chunk = ECOUART_BRIDGE_CHUNK_DEFAULT,
+    .tx_busy = false,
+    .rx_next = 0,
+};
+
+static void ecouart_bridge_tx_start(void) {
+  uint8_t *data;
+  uint32_t len;
+
+  len = ring_buf_get_claim(&bridge_tx_ring, &data,
+                           ECOUART_BRIDGE_TX_RING_SIZE);
+  if (len == 0) {
+    self.tx_busy = false;
+    return;
+  }
+
+  /* O DMA lê direto do ring; a região é liberada em UART_TX_DONE. */
+  if (uart_tx(self.uart, data, len, SYS_FOREVER_US) == 0) {
+    self.tx_busy = true;
+  } else {
+    ring_buf_get_finish(&bridge_tx_ring, 0);
+    self.tx_busy = false;
+  }
+}
+
+static void ecouart_bridge_uart_cb(const struct device *dev,
+                                   struct uart_event *evt, void *user_data) {
+  k_spinlock_key_t key;
+  uint32_t written;
+
+  ARG_UNUSED(user_data);
+
+  switch (evt->type) {
+  case UART_TX_DONE:
+  case UART_TX_ABORTED:
+    key = k_spin_lock(&self.lock);
+    ring_buf_get_finish(&bridge_tx_ring, evt->data.tx.len);
+    self.stats.tx_bytes += evt->data.tx.len;
+    ecouart_bridge_tx_start();
+    k_spin_unlock(&self.lock, key);
+    break;
+
+  case UART_RX_RDY:
+    key = k_spin_lock(&self.lock);
+    written = ring_buf_put(&bridge_rx_ring,
+                           evt->data.rx.buf + evt->data.rx.offset,
+                           evt->data.rx.len);
+    self.stats.rx_bytes += evt->data.rx.len;
+    self.stats.rx_dropped += evt->data.rx.len - written;
+    k_spin_unlock(&self.lock, key);
+    k_sem_give(&bridge_rx_sem);
+    break;
+
+  case UART_RX_BUF_REQUEST:
+    /* Alterna entre os dois buffers para a recepção não parar. */
+    uart_rx_buf_rsp(dev, self.rx_dma[self.rx_next],
+                    ECOUART_BRIDGE_RX_DMA_SIZE);
+    self.rx_next ^= 1;
+    break;
+
+  case UART_RX_STOPPED:
+    self.stats.uart_errors++;
+    break;
+
+  case UART_RX_DISABLED:
+    /* Depois de um erro de linha o driver desliga a recepção. */
+    self.rx_next = 1;
+    uart_rx_enable(dev, self.rx_dma[0], ECOUART_BRIDGE_RX_DMA_SIZE,
+                   ECOUART_BRIDGE_RX_TIMEOUT_US);
+    break;
+
+  default:
+    break;
+  }
+}
+
+static void ecouart_bridge_task(void) {
+  k_spinlock_key_t key;
+  uint8_t *data;
+  uint32_t len;
+  int err;
+
+  while (true) {
+    k_sem_take(&bridge_rx_sem, K_FOREVER);
+
+    while (true) {
+      /* Entrega direto do ring, sem cópia; o BLE copia para seu buffer. */
+      key = k_spin_lock(&self.lock);
+      len = ring_buf_get_claim(&bridge_rx_ring, &data, self.chunk);
+      k_spin_unlock(&self.lock, key);
+
+      if (len == 0) {
+        break;
+      }
+
+      /* Sem buffers no controlador, espera em vez de descartar. */
+      while ((err = self.rx_cb(data, len)) == -ENOMEM || err == -EAGAIN) {
+        k_sleep(K_MSEC(1));
+      }
+
+      key = k_spin_lock(&self.lock);
+      ring_buf_get_finish(&bridge_rx_ring, len);
+      if (err) {
+        self.stats.rx_dropped += len;
+      } else {
+        self.stats.rx_chunks++;
+      }
+      k_spin_unlock(&self.lock, key);
+    }
+  }
+}
+
+int ecouart_bridge_init(ecouart_bridge_rx_cb_t rx_cb) {
+  int err = 0;
+
+  if (!device_is_ready(self.uart)) {
+    printk("|BRIDGE| UART not ready.\n");
+    return -ENODEV;
+  }
+
+  self.rx_cb = rx_cb;
+
+  err = uart_callback_set(self.uart, ecouart_bridge_uart_cb, NULL);
+  if (err) {
+    printk("|BRIDGE| Async API unavailable (err %d).\n", err);
+    return err;
+  }
+
+  self.rx_next = 1;
+  err = uart_rx_enable(self.uart, self.rx_dma[0], ECOUART_BRIDGE_RX_DMA_SIZE,
+                       ECOUART_BRIDGE_RX_TIMEOUT_US);
+  if (err) {
+    printk("|BRIDGE| RX enable failed (err %d).\n", err);
+    return err;
+  }
+
+  printk("|BRIDGE| Bridge started on %s.\n", self.uart->name);
+
+  return 0;
+}
+
+size_t ecouart_bridge_write(const uint8_t *data, size_t len) {
+  k_spinlock_key_t key;
+  uint32_t written;
+
+  key = k_spin_lock(&self.lock);
+  written = ring_buf_put(&bridge_tx_ring, data, len);
+  self.stats.tx_dropped += len - written;
+  if (!self.tx_busy) {
+    ecouart_bridge_tx_start();
+  }
+  k_spin_unlock(&self.lock, key);
+
+  return written;
+}
+
+void ecouart_bridge_set_chunk(size_t chunk) {
+  self.chunk = MIN(MAX(chunk, 1), ECOUART_BRIDGE_CHUNK_MAX);
+}
+
+void ecouart_bridge_get_stats(struct ecouart_bridge_stats *stats) {
+  k_spinlock_key_t key = k_spin_lock(&self.lock);
+
+  *stats = self.stats;
+  k_spin_unlock(&self.lock, key);
+}
+
+void ecouart_bridge_print_stats(const char *tag) {
+  struct ecouart_bridge_stats stats;
+
+  ecouart_bridge_get_stats(&stats);
+  printk("%s Bridge tx=%u tx_drop=%u rx=%u rx_drop=%u chunks=%u errors=%u.\n",
+         tag, stats.tx_bytes, stats.tx_dropped, stats.rx_bytes,
+         stats.rx_dropped, stats.rx_chunks, stats.uart_errors);
+}
+#endif
@@ -0,0 +1,134 @@
+/**
+ * @file ecouart_clock.c
+ * @brief Implementação do relógio de microssegundos do Ecouart.
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "ecouart_clock.h"
+
+/**
+ * @brief Período de leitura do contador, bem abaixo de sua volta, para
+ * estendê-lo a 64 bits. O TIMER2 a 16 MHz volta em ~268 s; o contador do
+ * kernel do nRF52, em ~36 h.
+ *
+ */
+#define ECOUART_CLOCK_REFRESH_MS 10000
+
+/**
+ * @brief Inicia a leitura periódica do contador.
+ *
+ * @param dev Não utilizado.
+ * @return int Sempre 0.
+ */
+static int ecouart_clock_init(const struct device *dev);
+
+/**
+ * @brief Lê o contador periodicamente para não perder voltas.
+ *
+ * @param timer [in] Não utilizado.
+ */
+static void ecouart_clock_refresh(struct k_timer *timer);
+
+/**
+ * @brief Lê os 32 bits do contador em uso.
+ *
+ * @return uint32_t Valor atual do contador.
+ */
+static uint32_t ecouart_clock_read(void);
+
+/**
+ * @brief Contador de hardware estendido a 64 bits.
+ *
+ * @return uint64_t Ciclos do contador desde a inicialização.
+ */
+static uint64_t ecouart_clock_cycles(void);
+
+SYS_INIT(ecouart_clock_init, POST_KERNEL, 0);
+
+K_TIMER_DEFINE(ecouart_clock_timer, ecouart_clock_refresh, NULL);
+
+/**
+ * @brief Estrutura interna de variáveis.
+ *
+ */
+static struct {
+  const struct device *counter; /* TIMER2, ou NULL no contador do kernel. */
+  uint32_t freq;                /* Frequência do contador, em Hz. */
+  uint32_t last;                /* Última leitura do contador. */
+  uint64_t high;                /* Voltas acumuladas, nos 32 bits altos. */
+  struct k_spinlock lock;       /* Serializa a extensão do contador. */
+} self;
+
+static uint32_t ecouart_clock_read(void) {
+#if ECOUART_CLOCK_COUNTER
+  uint32_t ticks;
+
+  if (self.counter != NULL) {
+    (void)counter_get_value(self.counter, &ticks);
+    return ticks;
+  }
+#endif
+
+  return k_cycle_get_32();
+}
+
+static uint64_t ecouart_clock_cycles(void) {
+  k_spinlock_key_t key = k_spin_lock(&self.lock);
+  uint32_t now = ecouart_clock_read();
+  uint64_t cycles;
+
+  if (now < self.last) {
+    self.high += BIT64(32);
+  }
+  self.last = now;
+  cycles = self.high | now;
+
+  k_spin_unlock(&self.lock, key);
+
+  return cycles;
+}
+
+static void ecouart_clock_refresh(struct k_timer *timer) {
+  ARG_UNUSED(timer);
+
+  (void)ecouart_clock_cycles();
+}
+
+static int ecouart_clock_init(const struct device *dev) {
+  ARG_UNUSED(dev);
+
+  /* Ao contrário do contador de ciclos do DWT, que para junto com a CPU em
+   * WFI, o TIMER e o contador do kernel medem tempo decorrido mesmo com o nó
+   * ocioso. */
+  self.freq = sys_clock_hw_cycles_per_sec();
+#if ECOUART_CLOCK_COUNTER
+  self.counter = DEVICE_DT_GET(DT_NODELABEL(timer2));
+  if (!device_is_ready(self.counter) || counter_start(self.counter)) {
+    printk("|SYNC| TIMER2 unavailable, using the kernel counter.\n");
+    self.counter = NULL;
+  } else {
+    self.freq = counter_get_frequency(self.counter);
+  }
+#endif
+  self.last = ecouart_clock_read();
+  k_timer_start(&ecouart_clock_timer, K_MSEC(ECOUART_CLOCK_REFRESH_MS),
+                K_MSEC(ECOUART_CLOCK_REFRESH_MS));
+
+  return 0;
+}
+
+uint64_t ecouart_clock_us(void) {
+  uint64_t cycles = ecouart_clock_cycles();
+
+  /* Em duas partes, sem estourar 64 bits após dias a 16 MHz. */
+  return (cycles / self.freq) * USEC_PER_SEC +
+         (cycles % self.freq) * USEC_PER_SEC / self.freq;
+}
+
+uint32_t ecouart_clock_resolution_ns(void) {
+  return MAX(NSEC_PER_SEC / self.freq, 1);
+}
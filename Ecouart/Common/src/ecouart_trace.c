@@ -0,0 +1,20 @@
+/**
+ * @file ecouart_trace.c
+ * @brief Implementação dos marcadores de tracing das etapas do Ecouart.
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "ecouart_trace.h"
+
+#if defined(CONFIG_TRACING_CTF)
+#include <ctf_top.h>
+
+void ecouart_trace_mark(enum ecouart_trace_stage stage, uint32_t arg) {
+  CTF_EVENT(CTF_LITERAL(uint8_t, ECOUART_TRACE_CTF_ID),
+            CTF_LITERAL(uint8_t, stage), arg);
+}
+#endif
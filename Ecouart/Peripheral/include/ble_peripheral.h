@@ -25,6 +25,11 @@
 #include <zephyr.h>
 #include <zephyr/types.h>
 
+#include "ecouart_boot.h"
+#include "ecouart_bridge.h"
+#include "ecouart_clock.h"
+#include "ecouart_trace.h"
+#include "message_journal.h"
 #include "stdint.h"
 #include "stdlib.h"
 #include "string.h"
@@ -67,6 +72,57 @@
 #define BLE_UART_WRITE_CHAR_UUID                                               \
   BT_UUID_DECLARE_16(BLE_UART_WRITE_CHAR_UUID_VAL)
 
+/**
+ * @brief Valor do UUID da característica do diário de mensagens. Uma escrita
+ * de 4 bytes (sequência inicial, LE) pede o download; os registros chegam
+ * por notify nesta mesma característica.
+ *
+ */
+#define BLE_UART_JOURNAL_CHAR_UUID_VAL 0x2BC7
+
+/**
+ * @brief UUID da característica do diário de mensagens.
+ *
+ */
+#define BLE_UART_JOURNAL_CHAR_UUID                                             \
+  BT_UUID_DECLARE_16(BLE_UART_JOURNAL_CHAR_UUID_VAL)
+
+/**
+ * @brief Valor do UUID da característica de sincronização de relógio. O
+ * Central escreve pedidos e recebe por notify as respostas e os carimbos das
+ * suas escritas, no formato de ecouart_clock.h.
+ *
+ */
+#define BLE_UART_SYNC_CHAR_UUID_VAL 0x2BC8
+
+/**
+ * @brief UUID da característica de sincronização de relógio.
+ *
+ */
+#define BLE_UART_SYNC_CHAR_UUID BT_UUID_DECLARE_16(BLE_UART_SYNC_CHAR_UUID_VAL)
+
+/**
+ * @brief Parâmetros de advertising. No perfil de inicialização rápida o
+ * intervalo cai para 20 ms, o mínimo para advertising conectável, para o
+ * Central encontrar o Peripheral logo após um power cycle.
+ *
+ */
+#if defined(ECOUART_FAST_START)
+#define BLE_PERIPHERAL_ADV_PARAM                                               \
+  BT_LE_ADV_PARAM(BT_LE_ADV_OPT_CONNECTABLE | BT_LE_ADV_OPT_USE_NAME, 0x0020, \
+                  0x0020, NULL)
+#else
+#define BLE_PERIPHERAL_ADV_PARAM BT_LE_ADV_CONN_NAME
+#endif
+
+/**
+ * @brief Centrals lembrados para retomar o diário. Cada um guarda o
+ * intervalo de sequências registrado durante sua última conexão, que ele já
+ * recebeu ao vivo; o mais antigo é substituído quando a tabela enche.
+ *
+ */
+#define BLE_PERIPHERAL_JOURNAL_PEERS 4
+
 /**
  * @brief Inicializa a stack bluetooth com lógica BLE UART Peripheral.
  *
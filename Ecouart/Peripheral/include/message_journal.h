@@ -0,0 +1,140 @@
+/**
+ * @file message_journal.h
+ * @brief Interface do diário de mensagens do Peripheral. Os payloads
+ * recebidos são numerados e agrupados em lotes na RAM; cada lote vira uma
+ * única entrada do FCB (flash circular buffer) na partição storage, de forma
+ * que a flash recebe poucas escritas grandes em vez de uma por mensagem. Um
+ * Central que reconecta pede tudo a partir de uma sequência e recebe os
+ * registros empacotados em notificações do tamanho da MTU.
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef MESSAGE_JOURNAL_H_
+#define MESSAGE_JOURNAL_H_
+
+#include <fs/fcb.h>
+#include <storage/flash_map.h>
+#include <sys/byteorder.h>
+#include <sys/printk.h>
+#include <zephyr.h>
+
+#include "stdint.h"
+#include "string.h"
+
+/**
+ * @brief Tamanho de um lote em RAM, em bytes. Um setor de 4 KiB da nRF52840
+ * recebe quatro lotes cheios, então cada página é escrita em poucas
+ * operações sequenciais: a FCB gasta 8 bytes no cabeçalho do setor e, por
+ * entrada, 4 no tamanho e 4 no CRC, então (4096 - 8) / 4 - 8 = 1014,
+ * arredondado para o bloco de escrita de 4 bytes.
+ *
+ */
+#define MESSAGE_JOURNAL_BATCH_SIZE 1012
+
+/**
+ * @brief Tempo sem mensagens após o qual um lote incompleto é gravado.
+ *
+ */
+#define MESSAGE_JOURNAL_FLUSH_MS 500
+
+/**
+ * @brief Quantidade máxima de setores usados pelo diário.
+ *
+ */
+#define MESSAGE_JOURNAL_MAX_SECTORS 16
+
+/**
+ * @brief Cabeçalho de um registro: sequência (u32 LE) e tamanho (u8). O
+ * mesmo formato é usado na flash e nas notificações de download.
+ *
+ */
+#define MESSAGE_JOURNAL_RECORD_HDR 5
+
+/**
+ * @brief Maior payload registrado; o excedente é truncado.
+ *
+ */
+#define MESSAGE_JOURNAL_PAYLOAD_MAX 244
+
+/**
+ * @brief Callback que envia uma notificação de download ao Central.
+ *
+ * @param data [in] Ponteiro para os registros empacotados.
+ * @param len Tamanho dos registros empacotados.
+ * @return int 0 para sucesso, -ENOMEM para tentar de novo e outro inteiro
+ * negativo para abortar o download.
+ */
+typedef int (*message_journal_send_t)(const uint8_t *data, uint16_t len);
+
+/**
+ * @brief Contadores do diário.
+ *
+ */
+struct message_journal_stats {
+  uint32_t records;       /* Registros aceitos. */
+  uint32_t payload_bytes; /* Bytes de payload aceitos. */
+  uint32_t dropped;       /* Registros descartados com os dois lotes cheios. */
+  uint32_t batches;       /* Lotes gravados na flash. */
+  uint32_t flash_bytes;   /* Bytes gravados na flash, com cabeçalhos. */
+  uint32_t flash_us;      /* Tempo gasto em escritas e apagamentos. */
+  uint32_t rotations;     /* Setores apagados para reaproveitamento. */
+  uint32_t dl_records;    /* Registros enviados no último download. */
+  uint32_t dl_bytes;      /* Bytes notificados no último download. */
+  uint32_t dl_ms;         /* Duração do último download. */
+};
+
+/**
+ * @brief Pede a montagem do FCB na partição storage. A montagem e a
+ * varredura que retoma a numeração rodam na tarefa do diário, depois da
+ * inicialização do Bluetooth; até lá os registros são descartados.
+ *
+ * @param send Callback usado para enviar as notificações de download.
+ * @return int 0 para sucesso e um inteiro negativo em caso de falha.
+ */
+int message_journal_init(message_journal_send_t send);
+
+/**
+ * @brief Registra um payload recebido, sem acessar a flash.
+ *
+ * @param data [in] Ponteiro para o payload.
+ * @param len Tamanho do payload.
+ * @return int 0 para sucesso, -EAGAIN antes da montagem ou -ENOMEM se o
+ * registro foi descartado.
+ */
+int message_journal_append(const void *data, uint16_t len);
+
+/**
+ * @brief Pede o envio de todos os registros a partir de uma sequência. O
+ * download começa com um registro vazio com a sequência inicial, e termina
+ * com outro cuja sequência é a próxima a ser usada.
+ *
+ * @param from_seq Primeira sequência desejada.
+ * @param chunk Tamanho máximo de cada notificação (MTU - 3).
+ */
+void message_journal_request(uint32_t from_seq, uint16_t chunk);
+
+/**
+ * @brief Próxima sequência a ser usada, incluindo registros ainda em RAM.
+ *
+ * @return uint32_t Sequência do próximo registro aceito.
+ */
+uint32_t message_journal_head(void);
+
+/**
+ * @brief Copia os contadores do diário.
+ *
+ * @param stats [out] Ponteiro para estrutura que recebe os contadores.
+ */
+void message_journal_get_stats(struct message_journal_stats *stats);
+
+/**
+ * @brief Imprime vazão de escrita e de download do diário.
+ *
+ */
+void message_journal_print_stats(void);
+
+#endif /* MESSAGE_JOURNAL_H_ */
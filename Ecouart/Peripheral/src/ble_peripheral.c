@@ -37,6 +37,93 @@ static int ble_peripheral_write_uart(struct bt_conn *conn,
                                      const void *buf, uint16_t len,
                                      uint16_t offset, uint8_t flags);
 
+#if ECOUART_BRIDGE_ENABLED
+/**
+ * @brief Callback da ponte que notifica o Central com um bloco lido da UART.
+ *
+ * @param data [in] Ponteiro para os dados lidos.
+ * @param len Tamanho dos dados lidos.
+ * @return int 0 para sucesso e um inteiro negativo em caso de falha.
+ */
+static int ble_peripheral_bridge_rx(const uint8_t *data, size_t len);
+#endif
+
+/**
+ * @brief Callback que trata o pedido de download do diário.
+ *
+ * @param conn [in] Ponteiro para estrutura de handle de conexão.
+ * @param attr [in] Ponteiro para estrutura do atributo atualizado.
+ * @param buf [in]  Ponteiro para a sequência inicial, 4 bytes LE.
+ * @param len Tamanho do buffer dos dados escritos.
+ * @param offset Offset de escrita.
+ * @param flags Flags que indicam o modo de escrita.
+ * @return int Bytes aceitos ou erro ATT.
+ */
+static ssize_t ble_peripheral_write_journal(struct bt_conn *conn,
+                                            const struct bt_gatt_attr *attr,
+                                            const void *buf, uint16_t len,
+                                            uint16_t offset, uint8_t flags);
+
+/**
+ * @brief Callback que responde a um pedido de sincronização com os instantes
+ * de recepção e de envio, no relógio do Peripheral.
+ *
+ * @param conn [in] Ponteiro para estrutura de handle de conexão.
+ * @param attr [in] Ponteiro para estrutura do atributo atualizado.
+ * @param buf [in]  Ponteiro para o pedido.
+ * @param len Tamanho do pedido.
+ * @param offset Offset de escrita.
+ * @param flags Flags que indicam o modo de escrita.
+ * @return int Bytes aceitos ou erro ATT.
+ */
+static ssize_t ble_peripheral_write_sync(struct bt_conn *conn,
+                                         const struct bt_gatt_attr *attr,
+                                         const void *buf, uint16_t len,
+                                         uint16_t offset, uint8_t flags);
+
+/**
+ * @brief Envia ao Central o carimbo de uma escrita recebida, se ele estiver
+ * inscrito na característica de sincronização.
+ *
+ * @param conn [in] Ponteiro para estrutura de handle de conexão.
+ * @param seq Sequência da escrita desde a conexão.
+ * @param flags Flags ECOUART_SYNC_STAMP_*.
+ * @param t_rx Instante da recepção da escrita.
+ * @param t_tx Instante do envio do eco.
+ */
+static void ble_peripheral_send_stamp(struct bt_conn *conn, uint16_t seq,
+                                      uint8_t flags, uint64_t t_rx,
+                                      uint64_t t_tx);
+
+/**
+ * @brief Envia uma notificação de download do diário.
+ *
+ * @param data [in] Ponteiro para os registros empacotados.
+ * @param len Tamanho dos registros empacotados.
+ * @return int 0 para sucesso e um inteiro negativo em caso de falha.
+ */
+static int ble_peripheral_send_journal(const uint8_t *data, uint16_t len);
+
+/**
+ * @brief Sessão anterior de um Central, para retomar o diário.
+ *
+ */
+struct ble_peripheral_peer {
+  bt_addr_le_t addr;  /* Endereço do Central. */
+  bool valid;         /* Entrada preenchida. */
+  uint32_t live_from; /* Primeira sequência registrada na sessão. */
+  uint32_t live_to;   /* Próxima sequência ao fim da sessão. */
+};
+
+/**
+ * @brief Busca a sessão anterior de um Central.
+ *
+ * @param addr [in] Endereço do Central.
+ * @return struct ble_peripheral_peer* Ponteiro para a entrada, ou NULL.
+ */
+static struct ble_peripheral_peer *
+ble_peripheral_find_peer(const bt_addr_le_t *addr);
+
 /**
  * @brief Callback que trata a stack bluetooth atualizando tamanho da MTU.
  *
@@ -63,6 +150,15 @@ static void ble_peripheral_connected(struct bt_conn *conn, uint8_t err);
  */
 static void ble_peripheral_disconnected(struct bt_conn *conn, uint8_t reason);
 
+/**
+ * @brief Obtém uma referência à conexão ativa, para uso fora da thread do
+ * Bluetooth.
+ *
+ * @return struct bt_conn* Conexão com referência própria, liberada com
+ * bt_conn_unref, ou NULL sem conexão.
+ */
+static struct bt_conn *ble_peripheral_get_conn(void);
+
 /**
  * @brief Callback que trata a stack bluetooth após o mesmo estar pronto.
  *
@@ -78,6 +174,12 @@ static struct {
   struct bt_gatt_cb gatt_callbacks; /* Estrutura de callbacks de GATT. */
   struct bt_conn_cb conn_callbacks; /* Estrutura de callbacks de conexão. */
   struct bt_conn *default_conn; /* Ponteiro para handle de conexões ativas. */
+  struct k_spinlock lock;       /* Protege default_conn. */
+  uint16_t write_seq; /* Escritas recebidas desde a conexão. */
+  uint32_t live_from; /* Sequência do diário no início da conexão. */
+  struct ble_peripheral_peer
+      peers[BLE_PERIPHERAL_JOURNAL_PEERS]; /* Sessões anteriores. */
+  uint8_t peer_next; /* Próxima entrada a substituir. */
 } self = {
     .gatt_callbacks =
         {
@@ -89,6 +191,9 @@ static struct {
             .disconnected = ble_peripheral_disconnected,
         },
     .default_conn = NULL,
+    .write_seq = 0,
+    .live_from = 0,
+    .peer_next = 0,
 };
 
 /**
@@ -112,9 +217,35 @@ BT_GATT_SERVICE_DEFINE(
     BT_GATT_CHARACTERISTIC(BLE_UART_WRITE_CHAR_UUID, BT_GATT_CHRC_WRITE,
                            BT_GATT_PERM_WRITE, NULL, ble_peripheral_write_uart,
                            NULL),
+    BT_GATT_CCC(ble_peripheral_cfg_changed,
+                (BT_GATT_PERM_READ | BT_GATT_PERM_WRITE)),
+    BT_GATT_CHARACTERISTIC(BLE_UART_JOURNAL_CHAR_UUID,
+                           (BT_GATT_CHRC_WRITE | BT_GATT_CHRC_NOTIFY),
+                           BT_GATT_PERM_WRITE, NULL,
+                           ble_peripheral_write_journal, NULL),
+    BT_GATT_CCC(ble_peripheral_cfg_changed,
+                (BT_GATT_PERM_READ | BT_GATT_PERM_WRITE)),
+    BT_GATT_CHARACTERISTIC(BLE_UART_SYNC_CHAR_UUID,
+                           (BT_GATT_CHRC_WRITE_WITHOUT_RESP |
+                            BT_GATT_CHRC_NOTIFY),
+                           BT_GATT_PERM_WRITE, NULL, ble_peripheral_write_sync,
+                           NULL),
     BT_GATT_CCC(ble_peripheral_cfg_changed,
                 (BT_GATT_PERM_READ | BT_GATT_PERM_WRITE)), );
 
+/**
+ * @brief Índice da declaração da característica do diário em ble_uart_svc.
+ *
+ */
+#define BLE_PERIPHERAL_JOURNAL_ATTR 6
+
+/**
+ * @brief Índice da declaração da característica de sincronização em
+ * ble_uart_svc.
+ *
+ */
+#define BLE_PERIPHERAL_SYNC_ATTR 9
+
 static void ble_peripheral_cfg_changed(const struct bt_gatt_attr *attr,
                                        uint16_t value) {
   ARG_UNUSED(attr);
@@ -131,6 +262,23 @@ static int ble_peripheral_write_uart(struct bt_conn *conn,
                                      uint16_t offset, uint8_t flags) {
   int err = 0;
   char data[len + 1];
+  /* Primeira leitura: o tempo de processamento parte daqui. */
+  uint64_t t_rx = ecouart_clock_us();
+  uint16_t seq = self.write_seq++;
+  uint64_t t_tx;
+
+  ECOUART_TRACE(ECOUART_TRACE_WRITE_RX, len);
+  ecouart_boot_mark(ECOUART_BOOT_FIRST_DATA);
+
+  /* Só copia para o lote em RAM; a flash é gravada pela tarefa do diário. */
+  message_journal_append(buf, len);
+
+#if ECOUART_BRIDGE_ENABLED
+  /* Modo ponte: os dados seguem sem alteração para a UART. */
+  ecouart_bridge_write(buf, len);
+  ble_peripheral_send_stamp(conn, seq, 0, t_rx, ecouart_clock_us());
+  return len;
+#endif
 
   /* Copia dados recebidos. */
   memcpy(data, buf, len);
@@ -148,40 +296,221 @@ static int ble_peripheral_write_uart(struct bt_conn *conn,
   printk("|BLE PERIPHERAL| Sending data %s.\n", data);
 
   /* Notifica Central com o dados convertidos. */
+  ECOUART_TRACE(ECOUART_TRACE_NOTIFY_TX, len);
+  t_tx = ecouart_clock_us();
   err = bt_gatt_notify(NULL, &ble_uart_svc.attrs[1], data, len);
   if (err) {
     printk("|BLE PERIPHERAL| Error notifying.\n");
   }
 
+  ble_peripheral_send_stamp(conn, seq, err ? 0 : ECOUART_SYNC_STAMP_ECHOED,
+                            t_rx, t_tx);
+
   return 0;
 }
 
+static struct ble_peripheral_peer *
+ble_peripheral_find_peer(const bt_addr_le_t *addr) {
+  for (int i = 0; i < BLE_PERIPHERAL_JOURNAL_PEERS; i++) {
+    if (self.peers[i].valid && !bt_addr_le_cmp(&self.peers[i].addr, addr)) {
+      return &self.peers[i];
+    }
+  }
+
+  return NULL;
+}
+
+static ssize_t ble_peripheral_write_journal(struct bt_conn *conn,
+                                            const struct bt_gatt_attr *attr,
+                                            const void *buf, uint16_t len,
+                                            uint16_t offset, uint8_t flags) {
+  struct ble_peripheral_peer *peer;
+  uint32_t from_seq;
+
+  if (offset != 0 || len != sizeof(uint32_t)) {
+    return BT_GATT_ERR(BT_ATT_ERR_INVALID_ATTRIBUTE_LEN);
+  }
+
+  from_seq = sys_get_le32(buf);
+
+  /* O que o Central escreveu na última sessão ele já recebeu ao vivo. Só
+   * é pulado se ele já tinha tudo antes dela, ou seja, se o download
+   * daquela sessão terminou. */
+  peer = ble_peripheral_find_peer(bt_conn_get_dst(conn));
+  if (peer != NULL && from_seq >= peer->live_from &&
+      from_seq < peer->live_to) {
+    from_seq = peer->live_to;
+  }
+
+  message_journal_request(from_seq, bt_gatt_get_mtu(conn) - 3);
+
+  return len;
+}
+
+static ssize_t ble_peripheral_write_sync(struct bt_conn *conn,
+                                         const struct bt_gatt_attr *attr,
+                                         const void *buf, uint16_t len,
+                                         uint16_t offset, uint8_t flags) {
+  uint64_t t2 = ecouart_clock_us();
+  const uint8_t *req = buf;
+  uint8_t rsp[ECOUART_SYNC_RSP_LEN];
+  int err;
+
+  if (offset != 0 || len != ECOUART_SYNC_REQ_LEN ||
+      req[0] != ECOUART_SYNC_OP_REQ) {
+    return BT_GATT_ERR(BT_ATT_ERR_INVALID_ATTRIBUTE_LEN);
+  }
+
+  rsp[0] = ECOUART_SYNC_OP_RSP;
+  rsp[1] = req[1];
+  sys_put_le64(t2, &rsp[2]);
+  /* t3 o mais perto possível do envio, para descontar o processamento. */
+  sys_put_le64(ecouart_clock_us(), &rsp[10]);
+
+  err = bt_gatt_notify(conn, &ble_uart_svc.attrs[BLE_PERIPHERAL_SYNC_ATTR],
+                       rsp, sizeof(rsp));
+  if (err) {
+    printk("|BLE PERIPHERAL| Sync response failed (err %d).\n", err);
+  }
+
+  return len;
+}
+
+static void ble_peripheral_send_stamp(struct bt_conn *conn, uint16_t seq,
+                                      uint8_t flags, uint64_t t_rx,
+                                      uint64_t t_tx) {
+  const struct bt_gatt_attr *attr =
+      &ble_uart_svc.attrs[BLE_PERIPHERAL_SYNC_ATTR];
+  uint8_t stamp[ECOUART_SYNC_STAMP_LEN];
+
+  if (!bt_gatt_is_subscribed(conn, attr, BT_GATT_CCC_NOTIFY)) {
+    return;
+  }
+
+  stamp[0] = ECOUART_SYNC_OP_STAMP;
+  stamp[1] = flags;
+  sys_put_le16(seq, &stamp[2]);
+  sys_put_le64(t_rx, &stamp[4]);
+  sys_put_le64(t_tx, &stamp[12]);
+
+  /* Sem buffer, o carimbo é perdido; o Central contabiliza a falta. */
+  (void)bt_gatt_notify(conn, attr, stamp, sizeof(stamp));
+}
+
+static struct bt_conn *ble_peripheral_get_conn(void) {
+  struct bt_conn *conn = NULL;
+  k_spinlock_key_t key;
+
+  key = k_spin_lock(&self.lock);
+  if (self.default_conn != NULL) {
+    conn = bt_conn_ref(self.default_conn);
+  }
+  k_spin_unlock(&self.lock, key);
+
+  return conn;
+}
+
+static int ble_peripheral_send_journal(const uint8_t *data, uint16_t len) {
+  struct bt_conn *conn;
+  int err = 0;
+
+  /* Chamada pela tarefa do diário: a referência vale até o fim do notify. */
+  conn = ble_peripheral_get_conn();
+  if (conn == NULL) {
+    return -ENOTCONN;
+  }
+
+  err = bt_gatt_notify(conn, &ble_uart_svc.attrs[BLE_PERIPHERAL_JOURNAL_ATTR],
+                       data, len);
+  bt_conn_unref(conn);
+
+  return err;
+}
+
+#if ECOUART_BRIDGE_ENABLED
+static int ble_peripheral_bridge_rx(const uint8_t *data, size_t len) {
+  struct bt_conn *conn;
+  int err = 0;
+
+  /* Chamada pela tarefa da ponte: a referência vale até o fim do notify. */
+  conn = ble_peripheral_get_conn();
+  if (conn == NULL) {
+    return -ENOTCONN;
+  }
+
+  ECOUART_TRACE(ECOUART_TRACE_NOTIFY_TX, len);
+  err = bt_gatt_notify(conn, &ble_uart_svc.attrs[1], data, len);
+  bt_conn_unref(conn);
+
+  return err;
+}
+#endif
+
 static void ble_peripheral_mtu_updated(struct bt_conn *conn, uint16_t tx,
                                        uint16_t rx) {
   printk("|BLE PERIPHERAL| Updated MTU. TX:%d RX:%d bytes.\n", tx, rx);
+
+#if ECOUART_BRIDGE_ENABLED
+  /* Cada notify carrega até MTU - 3 bytes (cabeçalho ATT). */
+  ecouart_bridge_set_chunk(tx - 3);
+#endif
 }
 
 static void ble_peripheral_connected(struct bt_conn *conn, uint8_t err) {
+  k_spinlock_key_t key;
+
   if (err) {
     printk("|BLE PERIPHERAL| Peripheral Connection failed (err %u).\n", err);
   } else {
+    key = k_spin_lock(&self.lock);
     self.default_conn = bt_conn_ref(conn);
+    k_spin_unlock(&self.lock, key);
+    self.write_seq = 0;
+    self.live_from = message_journal_head();
+    ECOUART_TRACE(ECOUART_TRACE_CONNECTED, 0);
+    ecouart_boot_mark(ECOUART_BOOT_CONNECTED);
     printk("|BLE PERIPHERAL| Connected.\n");
   }
 }
 
 static void ble_peripheral_disconnected(struct bt_conn *conn, uint8_t reason) {
+  struct ble_peripheral_peer *peer;
+  struct bt_conn *old;
+  k_spinlock_key_t key;
   int err = 0;
   printk("|BLE PERIPHERAL| Disconnected, reason %u.\n", reason);
+  ECOUART_TRACE(ECOUART_TRACE_DISCONNECTED, reason);
+
+  message_journal_print_stats();
 
-  /* Decrementa conexão anterior do contador. */
-  if (self.default_conn) {
-    bt_conn_unref(self.default_conn);
-    self.default_conn = NULL;
+  /* Lembra o intervalo desta sessão para o próximo pedido de download. */
+  peer = ble_peripheral_find_peer(bt_conn_get_dst(conn));
+  if (peer == NULL) {
+    peer = &self.peers[self.peer_next];
+    self.peer_next = (self.peer_next + 1) % BLE_PERIPHERAL_JOURNAL_PEERS;
+    bt_addr_le_copy(&peer->addr, bt_conn_get_dst(conn));
+    peer->valid = true;
+  }
+  peer->live_from = self.live_from;
+  peer->live_to = message_journal_head();
+
+#if ECOUART_BRIDGE_ENABLED
+  ecouart_bridge_print_stats("|BLE PERIPHERAL|");
+  ecouart_bridge_set_chunk(ECOUART_BRIDGE_CHUNK_DEFAULT);
+#endif
+
+  /* Decrementa conexão anterior do contador; quem ainda a usa tem sua
+   * própria referência. */
+  key = k_spin_lock(&self.lock);
+  old = self.default_conn;
+  self.default_conn = NULL;
+  k_spin_unlock(&self.lock, key);
+  if (old) {
+    bt_conn_unref(old);
   }
 
   /* Volta a realizar o adversiting. */
-  err = bt_le_adv_start(BT_LE_ADV_CONN_NAME, ad, ARRAY_SIZE(ad), NULL, 0);
+  err = bt_le_adv_start(BLE_PERIPHERAL_ADV_PARAM, ad, ARRAY_SIZE(ad), NULL, 0);
   if (err) {
     printk("|BLE PERIPHERAL| Advertising failed to start (err %d).\n", err);
   }
@@ -194,19 +523,29 @@ static void ble_peripheral_ready(int init_err) {
     return;
   }
 
+  ecouart_boot_mark(ECOUART_BOOT_BT_READY);
+
   /* Inicializa Aversiting. */
-  err = bt_le_adv_start(BT_LE_ADV_CONN_NAME, ad, ARRAY_SIZE(ad), NULL, 0);
+  err = bt_le_adv_start(BLE_PERIPHERAL_ADV_PARAM, ad, ARRAY_SIZE(ad), NULL, 0);
   if (err) {
     printk("|BLE PERIPHERAL| Advertising failed to start (err %d).\n", err);
     return;
   }
 
+  ECOUART_TRACE(ECOUART_TRACE_ADV_START, 0);
+  ecouart_boot_mark(ECOUART_BOOT_LINK_START);
   printk("|BLE PERIPHERAL| Started advertising.\n");
 }
 
 int ble_peripheral_init() {
   int err = 0;
 
+  /* Sem diário o Peripheral segue funcionando, apenas sem histórico. */
+  err = message_journal_init(ble_peripheral_send_journal);
+  if (err) {
+    printk("|BLE PERIPHERAL| Journal unavailable (err %d).\n", err);
+  }
+
   /* Configura os callbacks necessários para o BLE. */
   bt_conn_cb_register(&self.conn_callbacks);
   bt_gatt_cb_register(&self.gatt_callbacks);
@@ -220,5 +559,12 @@ int ble_peripheral_init() {
 
   printk("|BLE PERIPHERAL| Bluetooth initialized.\n");
 
+#if ECOUART_BRIDGE_ENABLED
+  err = ecouart_bridge_init(ble_peripheral_bridge_rx);
+  if (err) {
+    return err;
+  }
+#endif
+
   return 0;
 }
\ No newline at end of file
@@ -17,6 +17,8 @@
 void main(void) {
   int err = 1;
 
+  ecouart_boot_mark(ECOUART_BOOT_MAIN);
+
   /* Inicializa lógica do Peripheral. */
   err = ble_peripheral_init();
 
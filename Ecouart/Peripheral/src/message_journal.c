@@ -0,0 +1,563 @@
+/**
+ * @file message_journal.c
+ * @brief Implementação do diário de mensagens do Peripheral sobre FCB.
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "message_journal.h"
+
+#if defined(CONFIG_FCB)
+/**
+ * @brief Marca de formato do FCB do diário ("EJNL").
+ *
+ */
+#define MESSAGE_JOURNAL_MAGIC 0x454a4e4c
+
+/**
+ * @brief Lote de registros acumulados em RAM.
+ *
+ */
+struct message_journal_batch {
+  uint16_t len;                             /* Bytes ocupados. */
+  uint8_t data[MESSAGE_JOURNAL_BATCH_SIZE]; /* Registros empacotados. */
+};
+
+/**
+ * @brief Estado de um download em curso.
+ *
+ */
+struct message_journal_download {
+  uint32_t from_seq; /* Primeira sequência pedida. */
+  uint16_t chunk;    /* Tamanho máximo de cada notificação. */
+  uint16_t len;      /* Bytes ocupados em packet. */
+  int err;           /* Falha de envio que abortou o download. */
+  uint8_t packet[MESSAGE_JOURNAL_PAYLOAD_MAX]; /* Notificação em montagem. */
+};
+
+/**
+ * @brief Grava um lote como uma entrada do FCB, apagando o setor mais antigo
+ * quando o diário está cheio.
+ *
+ * @param batch [in] Ponteiro para o lote.
+ * @return int 0 para sucesso e um inteiro negativo em caso de falha.
+ */
+static int message_journal_write(const struct message_journal_batch *batch);
+
+/**
+ * @brief Callback do fcb_walk que retoma a sequência na inicialização.
+ *
+ * @param loc_ctx [in] Ponteiro para a entrada visitada.
+ * @param arg [out] Ponteiro para a próxima sequência encontrada.
+ * @return int 0 para continuar.
+ */
+static int message_journal_scan_cb(struct fcb_entry_ctx *loc_ctx, void *arg);
+
+/**
+ * @brief Callback do fcb_walk que envia os registros de uma entrada.
+ *
+ * @param loc_ctx [in] Ponteiro para a entrada visitada.
+ * @param arg [in] Ponteiro para o estado do download.
+ * @return int 0 para continuar ou 1 para interromper.
+ */
+static int message_journal_send_cb(struct fcb_entry_ctx *loc_ctx, void *arg);
+
+/**
+ * @brief Acrescenta um registro à notificação em montagem, enviando-a antes
+ * se não houver espaço.
+ *
+ * @param dl [in] Ponteiro para o estado do download.
+ * @param seq Sequência do registro.
+ * @param data [in] Ponteiro para o payload.
+ * @param len Tamanho do payload.
+ * @return int 0 para sucesso e um inteiro negativo em caso de falha.
+ */
+static int message_journal_pack(struct message_journal_download *dl,
+                                uint32_t seq, const uint8_t *data,
+                                uint8_t len);
+
+/**
+ * @brief Envia a notificação em montagem, repetindo enquanto a stack
+ * Bluetooth estiver sem buffers.
+ *
+ * @param dl [in] Ponteiro para o estado do download.
+ * @return int 0 para sucesso e um inteiro negativo em caso de falha.
+ */
+static int message_journal_send_packet(struct message_journal_download *dl);
+
+/**
+ * @brief Executa um download pedido pelo Central.
+ *
+ * @param from_seq Primeira sequência pedida.
+ * @param chunk Tamanho máximo de cada notificação.
+ * @param end_seq Sequência do registro final; todas as anteriores já estão
+ * na flash.
+ */
+static void message_journal_download(uint32_t from_seq, uint16_t chunk,
+                                     uint32_t end_seq);
+
+/**
+ * @brief Grava o lote pendente, trocando antes o lote ativo se houver
+ * registros nele, o outro estiver livre e o diário estiver ocioso ou a troca
+ * for forçada.
+ *
+ * @param force Troca o lote ativo mesmo com registros recentes.
+ * @return uint32_t Próxima sequência no momento da troca. Se nenhum lote
+ * aguardava gravação na chamada, todas as anteriores estão na flash no
+ * retorno.
+ */
+static uint32_t message_journal_flush(bool force);
+
+/**
+ * @brief Monta o FCB e retoma a numeração a partir da última entrada.
+ *
+ * @return int 0 para sucesso e um inteiro negativo em caso de falha.
+ */
+static int message_journal_mount(void);
+
+/**
+ * @brief Tarefa que monta o diário, grava os lotes e atende os downloads,
+ * fora das threads do Bluetooth.
+ *
+ */
+static void message_journal_task(void);
+
+/**
+ * @brief Sinaliza lote cheio ou download pedido.
+ *
+ */
+K_SEM_DEFINE(journal_sem, 0, 1);
+
+/**
+ * @brief Protege os lotes, os pedidos e os contadores.
+ *
+ */
+K_MUTEX_DEFINE(journal_lock);
+
+/**
+ * @brief Define a tarefa do diário, abaixo das tarefas do Bluetooth.
+ *
+ */
+K_THREAD_DEFINE(journal, 2048, message_journal_task, NULL, NULL, NULL, 7, 0,
+                0);
+
+/**
+ * @brief Estrutura interna de variáveis.
+ *
+ */
+static struct {
+  struct fcb fcb;                    /* FCB na partição storage. */
+  struct flash_sector sectors[MESSAGE_JOURNAL_MAX_SECTORS]; /* Setores. */
+  struct message_journal_batch batches[2]; /* Lote ativo e em gravação. */
+  uint8_t active;                    /* Lote que recebe registros. */
+  bool pending;                      /* O outro lote aguarda gravação. */
+  bool ready;                        /* FCB montado. */
+  bool mount;                        /* Montagem pedida pelo init. */
+  uint32_t next_seq;                 /* Próxima sequência a ser usada. */
+  int64_t last_append_ms;            /* Uptime do último registro. */
+  uint32_t request_seq;              /* Sequência pedida pelo Central. */
+  uint16_t request_chunk;            /* Bloco pedido, 0 sem pedido. */
+  message_journal_send_t send;       /* Envio das notificações. */
+  uint8_t entry[MESSAGE_JOURNAL_BATCH_SIZE]; /* Entrada lida da flash. */
+  struct message_journal_stats stats; /* Contadores. */
+} self = {
+    .active = 0,
+    .pending = false,
+    .ready = false,
+    .mount = false,
+    .next_seq = 0,
+    .request_chunk = 0,
+    .send = NULL,
+};
+
+static int message_journal_write(const struct message_journal_batch *batch) {
+  struct fcb_entry loc;
+  uint32_t start = k_cycle_get_32();
+  uint16_t len = ROUND_UP(batch->len, 4);
+  int err;
+
+  /* Sem espaço, o setor mais antigo é apagado e reaproveitado. */
+  err = fcb_append(&self.fcb, len, &loc);
+  if (err == -ENOSPC) {
+    err = fcb_rotate(&self.fcb);
+    if (!err) {
+      self.stats.rotations++;
+      err = fcb_append(&self.fcb, len, &loc);
+    }
+  }
+  if (err) {
+    return err;
+  }
+
+  /* O preenchimento até o alinhamento da flash tem menos que um cabeçalho
+   * de registro, então a leitura o ignora. */
+  err = flash_area_write(self.fcb.fap, FCB_ENTRY_FA_DATA_OFF(loc), batch->data,
+                         len);
+  if (!err) {
+    err = fcb_append_finish(&self.fcb, &loc);
+  }
+
+  k_mutex_lock(&journal_lock, K_FOREVER);
+  self.stats.batches++;
+  self.stats.flash_bytes += len;
+  self.stats.flash_us += k_cyc_to_us_floor32(k_cycle_get_32() - start);
+  k_mutex_unlock(&journal_lock);
+
+  return err;
+}
+
+static int message_journal_scan_cb(struct fcb_entry_ctx *loc_ctx, void *arg) {
+  uint16_t len = MIN(loc_ctx->loc.fe_data_len, sizeof(self.entry));
+  uint16_t offset = 0;
+  uint32_t *next_seq = arg;
+
+  if (flash_area_read(loc_ctx->fap, FCB_ENTRY_FA_DATA_OFF(loc_ctx->loc),
+                      self.entry, len)) {
+    return 0;
+  }
+
+  while (offset + MESSAGE_JOURNAL_RECORD_HDR <= len) {
+    *next_seq = sys_get_le32(&self.entry[offset]) + 1;
+    offset += MESSAGE_JOURNAL_RECORD_HDR + self.entry[offset + 4];
+  }
+
+  return 0;
+}
+
+static int message_journal_send_packet(struct message_journal_download *dl) {
+  int err;
+
+  if (dl->len == 0) {
+    return 0;
+  }
+
+  while ((err = self.send(dl->packet, dl->len)) == -ENOMEM) {
+    k_sleep(K_MSEC(1));
+  }
+
+  if (!err) {
+    self.stats.dl_bytes += dl->len;
+  }
+  dl->len = 0;
+
+  return err;
+}
+
+static int message_journal_pack(struct message_journal_download *dl,
+                                uint32_t seq, const uint8_t *data,
+                                uint8_t len) {
+  int err;
+
+  /* Com MTU pequena, o registro é cortado para caber em uma notificação. */
+  len = MIN(len, dl->chunk - MESSAGE_JOURNAL_RECORD_HDR);
+
+  if (dl->len + MESSAGE_JOURNAL_RECORD_HDR + len > dl->chunk) {
+    err = message_journal_send_packet(dl);
+    if (err) {
+      return err;
+    }
+  }
+
+  sys_put_le32(seq, &dl->packet[dl->len]);
+  dl->packet[dl->len + 4] = len;
+  memcpy(&dl->packet[dl->len + MESSAGE_JOURNAL_RECORD_HDR], data, len);
+  dl->len += MESSAGE_JOURNAL_RECORD_HDR + len;
+
+  return 0;
+}
+
+static int message_journal_send_cb(struct fcb_entry_ctx *loc_ctx, void *arg) {
+  struct message_journal_download *dl = arg;
+  uint16_t len = MIN(loc_ctx->loc.fe_data_len, sizeof(self.entry));
+  uint16_t offset = 0;
+  uint32_t seq;
+  uint8_t rec_len;
+
+  if (flash_area_read(loc_ctx->fap, FCB_ENTRY_FA_DATA_OFF(loc_ctx->loc),
+                      self.entry, len)) {
+    return 0;
+  }
+
+  while (offset + MESSAGE_JOURNAL_RECORD_HDR <= len) {
+    seq = sys_get_le32(&self.entry[offset]);
+    rec_len = self.entry[offset + 4];
+
+    if (seq >= dl->from_seq) {
+      dl->err = message_journal_pack(
+          dl, seq, &self.entry[offset + MESSAGE_JOURNAL_RECORD_HDR], rec_len);
+      if (dl->err) {
+        return 1;
+      }
+      self.stats.dl_records++;
+    }
+
+    offset += MESSAGE_JOURNAL_RECORD_HDR + rec_len;
+  }
+
+  return 0;
+}
+
+static void message_journal_download(uint32_t from_seq, uint16_t chunk,
+                                     uint32_t end_seq) {
+  static struct message_journal_download dl;
+  int64_t start = k_uptime_get();
+
+  dl.from_seq = from_seq;
+  dl.chunk = MIN(chunk, sizeof(dl.packet));
+  dl.len = 0;
+  dl.err = 0;
+
+  self.stats.dl_records = 0;
+  self.stats.dl_bytes = 0;
+
+  /* Registro vazio inicial informa ao Central de onde o download parte, que
+   * pode estar além do pedido; só as sequências puladas depois dele foram
+   * sobrescritas. */
+  dl.err = message_journal_pack(&dl, from_seq, NULL, 0);
+  if (!dl.err) {
+    fcb_walk(&self.fcb, NULL, message_journal_send_cb, &dl);
+  }
+
+  /* Registro vazio final informa a próxima sequência ao Central. Registros
+   * posteriores a end_seq ainda podem estar só na RAM e ficam para o
+   * próximo download. */
+  if (!dl.err) {
+    dl.err = message_journal_pack(&dl, end_seq, NULL, 0);
+  }
+  if (!dl.err) {
+    dl.err = message_journal_send_packet(&dl);
+  }
+
+  self.stats.dl_ms = (uint32_t)(k_uptime_get() - start);
+
+  printk("|JOURNAL| Download from %u: %u records, %u bytes in %u ms%s.\n",
+         from_seq, self.stats.dl_records, self.stats.dl_bytes,
+         self.stats.dl_ms, dl.err ? " (aborted)" : "");
+}
+
+static uint32_t message_journal_flush(bool force) {
+  uint32_t next_seq;
+  uint8_t flush;
+  bool write;
+  bool idle;
+  int err;
+
+  k_mutex_lock(&journal_lock, K_FOREVER);
+  /* Lote incompleto é gravado antes de um download ou após
+   * MESSAGE_JOURNAL_FLUSH_MS sem registros; com tráfego contínuo e lento,
+   * ele continua enchendo em vez de virar várias entradas pequenas. */
+  idle = k_uptime_get() - self.last_append_ms >= MESSAGE_JOURNAL_FLUSH_MS;
+  if (!self.pending && self.batches[self.active].len > 0 && (force || idle)) {
+    self.pending = true;
+    self.active ^= 1;
+    self.batches[self.active].len = 0;
+  }
+  flush = self.active ^ 1;
+  write = self.pending;
+  next_seq = self.next_seq;
+  k_mutex_unlock(&journal_lock);
+
+  if (write) {
+    err = message_journal_write(&self.batches[flush]);
+    if (err) {
+      printk("|JOURNAL| Write failed (err %d).\n", err);
+    }
+
+    k_mutex_lock(&journal_lock, K_FOREVER);
+    self.pending = false;
+    k_mutex_unlock(&journal_lock);
+  }
+
+  return next_seq;
+}
+
+static void message_journal_task(void) {
+  uint32_t request_seq;
+  uint16_t request_chunk;
+  uint32_t end_seq;
+
+  while (true) {
+    k_sem_take(&journal_sem, K_MSEC(MESSAGE_JOURNAL_FLUSH_MS));
+
+    if (!self.ready) {
+      /* A varredura da flash fica para depois do Bluetooth subir. */
+      if (!self.mount || message_journal_mount()) {
+        self.mount = false;
+        continue;
+      }
+    }
+
+    k_mutex_lock(&journal_lock, K_FOREVER);
+    request_chunk = self.request_chunk;
+    request_seq = self.request_seq;
+    self.request_chunk = 0;
+    k_mutex_unlock(&journal_lock);
+
+    message_journal_flush(false);
+
+    if (request_chunk) {
+      /* A primeira passagem não troca o ativo se o outro lote aguardava
+       * gravação ou se houve registros recentes; a segunda força a troca, e
+       * a sequência devolvida cobre apenas registros que estão na flash. */
+      end_seq = message_journal_flush(true);
+      message_journal_download(request_seq, request_chunk, end_seq);
+    }
+  }
+}
+
+static int message_journal_mount(void) {
+  uint32_t sector_cnt = ARRAY_SIZE(self.sectors);
+  uint32_t next_seq = 0;
+  int err;
+
+  err = flash_area_get_sectors(FLASH_AREA_ID(storage), &sector_cnt,
+                               self.sectors);
+  if (err) {
+    printk("|JOURNAL| Storage partition unavailable (err %d).\n", err);
+    return err;
+  }
+
+  self.fcb.f_magic = MESSAGE_JOURNAL_MAGIC;
+  self.fcb.f_version = 1;
+  self.fcb.f_sectors = self.sectors;
+  self.fcb.f_sector_cnt = sector_cnt;
+  self.fcb.f_scratch_cnt = 0;
+
+  err = fcb_init(FLASH_AREA_ID(storage), &self.fcb);
+  if (err) {
+    printk("|JOURNAL| FCB init failed (err %d).\n", err);
+    return err;
+  }
+
+  /* A varredura lê a partição inteira; roda sem o lock para não bloquear
+   * as escritas do Bluetooth, que até a publicação abaixo são descartadas
+   * sem tocar em next_seq. */
+  fcb_walk(&self.fcb, NULL, message_journal_scan_cb, &next_seq);
+
+  k_mutex_lock(&journal_lock, K_FOREVER);
+  self.next_seq = next_seq;
+  self.ready = true;
+  k_mutex_unlock(&journal_lock);
+
+  printk("|JOURNAL| %u sectors, next sequence %u.\n", sector_cnt, next_seq);
+
+  return 0;
+}
+
+int message_journal_init(message_journal_send_t send) {
+  /* Só registra o pedido; a tarefa do diário, de baixa prioridade, monta o
+   * FCB sem atrasar o advertising. */
+  self.send = send;
+  self.mount = true;
+  k_sem_give(&journal_sem);
+
+  return 0;
+}
+
+int message_journal_append(const void *data, uint16_t len) {
+  struct message_journal_batch *batch;
+
+  len = MIN(len, MESSAGE_JOURNAL_PAYLOAD_MAX);
+
+  k_mutex_lock(&journal_lock, K_FOREVER);
+  batch = &self.batches[self.active];
+
+  /* Antes da montagem a próxima sequência ainda não é conhecida. */
+  if (!self.ready) {
+    self.stats.dropped++;
+    k_mutex_unlock(&journal_lock);
+    return -EAGAIN;
+  }
+
+  if (batch->len + MESSAGE_JOURNAL_RECORD_HDR + len > sizeof(batch->data)) {
+    if (self.pending) {
+      /* A flash não acompanha: os dois lotes estão ocupados. */
+      self.stats.dropped++;
+      k_mutex_unlock(&journal_lock);
+      return -ENOMEM;
+    }
+
+    /* Lote cheio segue para gravação; o outro passa a receber. */
+    self.pending = true;
+    self.active ^= 1;
+    batch = &self.batches[self.active];
+    batch->len = 0;
+    k_sem_give(&journal_sem);
+  }
+
+  sys_put_le32(self.next_seq++, &batch->data[batch->len]);
+  batch->data[batch->len + 4] = len;
+  memcpy(&batch->data[batch->len + MESSAGE_JOURNAL_RECORD_HDR], data, len);
+  batch->len += MESSAGE_JOURNAL_RECORD_HDR + len;
+
+  self.last_append_ms = k_uptime_get();
+  self.stats.records++;
+  self.stats.payload_bytes += len;
+  k_mutex_unlock(&journal_lock);
+
+  return 0;
+}
+
+void message_journal_request(uint32_t from_seq, uint16_t chunk) {
+  k_mutex_lock(&journal_lock, K_FOREVER);
+  self.request_seq = from_seq;
+  self.request_chunk = chunk;
+  k_mutex_unlock(&journal_lock);
+
+  k_sem_give(&journal_sem);
+}
+
+uint32_t message_journal_head(void) {
+  uint32_t next_seq;
+
+  k_mutex_lock(&journal_lock, K_FOREVER);
+  next_seq = self.next_seq;
+  k_mutex_unlock(&journal_lock);
+
+  return next_seq;
+}
+
+void message_journal_get_stats(struct message_journal_stats *stats) {
+  k_mutex_lock(&journal_lock, K_FOREVER);
+  *stats = self.stats;
+  k_mutex_unlock(&journal_lock);
+}
+
+void message_journal_print_stats(void) {
+  struct message_journal_stats stats;
+
+  message_journal_get_stats(&stats);
+
+  printk("|JOURNAL| records=%u payload=%u dropped=%u batches=%u flash=%u "
+         "rotations=%u write=%u B/s.\n",
+         stats.records, stats.payload_bytes, stats.dropped, stats.batches,
+         stats.flash_bytes, stats.rotations,
+         stats.flash_us
+             ? (uint32_t)(stats.flash_bytes * 1000000ULL / stats.flash_us)
+             : 0);
+  printk("|JOURNAL| last download records=%u bytes=%u rate=%u B/s.\n",
+         stats.dl_records, stats.dl_bytes,
+         stats.dl_ms ? (uint32_t)(stats.dl_bytes * 1000ULL / stats.dl_ms) : 0);
+}
+#else
+/* Sem FCB (build nativo), o Peripheral funciona sem histórico. */
+int message_journal_init(message_journal_send_t send) {
+  ARG_UNUSED(send);
+  return -ENOTSUP;
+}
+
+int message_journal_append(const void *data, uint16_t len) { return 0; }
+
+void message_journal_request(uint32_t from_seq, uint16_t chunk) {}
+
+uint32_t message_journal_head(void) { return 0; }
+
+void message_journal_get_stats(struct message_journal_stats *stats) {
+  memset(stats, 0, sizeof(*stats));
+}
+
+void message_journal_print_stats(void) {}
+#endif
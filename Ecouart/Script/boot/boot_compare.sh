@@ -0,0 +1,49 @@
+#!/usr/bin/env bash
+#
+# Compares boot-to-first-packet of the default and the fast-start Ecouart
+# builds under Renode.
+#
+# Build both images first:
+#   (cd Ecouart/Central && pio run -e nrf52840_dk -e nrf52840_dk_faststart)
+#   (cd Ecouart/Peripheral && pio run -e nrf52840_dk -e nrf52840_dk_faststart)
+#
+# Then:
+#   ./boot_compare.sh [virtual seconds] [seconds before typing the first line]
+#
+# Both machines power up together. Once the central's input task is up, one
+# line is typed into its console, so the first data milestone includes that
+# wait on both builds; the link milestones (bt_ready, link_start, connected)
+# are the ones the fast-start profile changes.
+
+set -euo pipefail
+
+HERE="$(cd "$(dirname "${BASH_SOURCE[0]}")" && pwd)"
+ROOT="${HERE}/../.."
+OUT="${HERE}/out"
+SECONDS_TO_RUN="${1:-5}"
+TYPE_AFTER="${2:-1.5}"
+RENODE="${RENODE:-renode}"
+LINE="boot"
+
+rm -rf "${OUT}"
+
+for env in nrf52840_dk nrf52840_dk_faststart; do
+  mkdir -p "${OUT}/${env}"
+
+  commands="\$central_bin=@${ROOT}/Central/.pio/build/${env}/firmware.elf"
+  commands+="; \$peripheral_bin=@${ROOT}/Peripheral/.pio/build/${env}/firmware.elf"
+  commands+="; \$central_log=@${OUT}/${env}/central.log"
+  commands+="; \$peripheral_log=@${OUT}/${env}/peripheral.log"
+  commands+="; include @${HERE}/boot.resc; mach set \"central\""
+  commands+="; emulation RunFor \"${TYPE_AFTER}\""
+  for ((i = 0; i < ${#LINE}; i++)); do
+    commands+="; sysbus.uart0 WriteChar $(printf '0x%02X' "'${LINE:i:1}")"
+  done
+  commands+="; sysbus.uart0 WriteChar 0x0D"
+  commands+="; emulation RunFor \"${SECONDS_TO_RUN}\"; quit"
+
+  "${RENODE}" --disable-xwt --console -e "${commands}"
+done
+
+python3 "${HERE}/boot_report.py" \
+  "${OUT}/nrf52840_dk" "${OUT}/nrf52840_dk_faststart"
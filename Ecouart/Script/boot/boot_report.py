@@ -0,0 +1,69 @@
+#!/usr/bin/env python3
+"""Boot-to-first-packet report for the Ecouart firmwares.
+
+Reads the `|BOOT|` lines that both firmwares print once the first data byte
+arrives and shows every milestone in milliseconds since reset. With two log
+directories (baseline and candidate, as written by boot_compare.sh) it also
+prints the gain of the candidate for each milestone.
+
+    python3 boot_report.py out/nrf52840_dk
+    python3 boot_report.py out/nrf52840_dk out/nrf52840_dk_faststart
+"""
+
+import os
+import re
+import sys
+
+STAGES = ("kernel", "main", "bt_ready", "link_start", "connected", "first_data")
+BOOT_RE = re.compile(
+    r'\|BOOT\| node="([^"]*)" '
+    + " ".join(r"%s=(\d+)" % stage for stage in STAGES)
+)
+
+
+def read_dir(path):
+    """Returns {node: {stage: us}} from every .log file in path."""
+    nodes = {}
+    for name in sorted(os.listdir(path)):
+        if not name.endswith(".log"):
+            continue
+        with open(os.path.join(path, name), errors="replace") as f:
+            for match in BOOT_RE.finditer(f.read()):
+                values = [int(v) for v in match.groups()[1:]]
+                nodes[match.group(1)] = dict(zip(STAGES, values))
+    return nodes
+
+
+def ms(us):
+    return "%9.1f" % (us / 1000.0) if us else "        -"
+
+
+def main():
+    if len(sys.argv) not in (2, 3):
+        print(__doc__.strip(), file=sys.stderr)
+        return 2
+
+    runs = [read_dir(path) for path in sys.argv[1:]]
+    labels = [os.path.basename(os.path.normpath(p)) for p in sys.argv[1:]]
+
+    for node in sorted(set().union(*runs)):
+        print(node)
+        header = "  %-12s" % "stage" + "".join("%24s" % l for l in labels)
+        if len(runs) == 2:
+            header += "%10s %7s" % ("gain ms", "gain")
+        print(header)
+
+        for stage in STAGES:
+            values = [run.get(node, {}).get(stage, 0) for run in runs]
+            line = "  %-12s" % stage + "".join("%21s ms" % ms(v) for v in values)
+            if len(runs) == 2 and all(values):
+                gain = values[0] - values[1]
+                line += "%10.1f %6.1f%%" % (gain / 1000.0, 100.0 * gain / values[0])
+            print(line)
+        print()
+
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,156 @@
+#!/usr/bin/env python3
+"""Full-duplex check of the Ecouart serial bridge.
+
+Connects to the bridged `uart1` of both nodes (bridge.resc sockets, or two real
+serial ports), streams a counter pattern into each end at the same time and
+verifies the bytes that come out of the other end. Reports per-direction
+throughput, lost bytes and the first corrupted offset.
+
+    python3 bridge_check.py                               # Renode, ports 3460/3461
+    python3 bridge_check.py --bytes 65536 --rate 50000    # paced to 50 kB/s per side
+    python3 bridge_check.py --serial /dev/ttyACM0 /dev/ttyACM1 --baud 1000000
+"""
+
+import argparse
+import socket
+import sys
+import threading
+import time
+
+CHUNK = 244
+
+
+def pattern(seed, length):
+    return bytes((seed + i * 7) & 0xFF for i in range(length))
+
+
+class SocketLink:
+    def __init__(self, host, port):
+        self.sock = socket.create_connection((host, port))
+        self.sock.settimeout(0.1)
+
+    def write(self, data):
+        self.sock.sendall(data)
+
+    def read(self):
+        try:
+            return self.sock.recv(65536)
+        except socket.timeout:
+            return b""
+
+
+class SerialLink:
+    def __init__(self, device, baud):
+        import serial
+
+        self.port = serial.Serial(device, baud, timeout=0.1, rtscts=False)
+
+    def write(self, data):
+        self.port.write(data)
+
+    def read(self):
+        return self.port.read(65536)
+
+
+class Direction:
+    def __init__(self, name, source, sink, data, rate, idle):
+        self.name = name
+        self.source = source
+        self.sink = sink
+        self.data = data
+        self.rate = rate
+        self.idle = idle
+        self.received = bytearray()
+        self.first_rx = None
+        self.last_rx = None
+        self.start = None
+
+    def send(self):
+        self.start = time.monotonic()
+        for offset in range(0, len(self.data), CHUNK):
+            self.source.write(self.data[offset:offset + CHUNK])
+            if self.rate:
+                # Keep the requested average rate without bursts past the firmware ring.
+                due = self.start + (offset + CHUNK) / self.rate
+                time.sleep(max(0.0, due - time.monotonic()))
+
+    def receive(self):
+        last_data = time.monotonic()
+        while len(self.received) < len(self.data):
+            data = self.sink.read()
+            now = time.monotonic()
+            if data:
+                self.first_rx = self.first_rx or now
+                self.last_rx = now
+                last_data = now
+                self.received += data
+            elif now - last_data > self.idle:
+                break
+
+    def report(self):
+        expected = self.data
+        got = bytes(self.received)
+        mismatch = next(
+            (i for i, (a, b) in enumerate(zip(expected, got)) if a != b), None
+        )
+        elapsed = (self.last_rx or self.start) - self.start
+        rate = len(got) / elapsed if elapsed > 0 else 0.0
+        print(
+            "%-22s sent=%d received=%d lost=%d first_mismatch=%s %.0f B/s"
+            % (
+                self.name,
+                len(expected),
+                len(got),
+                max(0, len(expected) - len(got)),
+                "none" if mismatch is None else mismatch,
+                rate,
+            )
+        )
+        return mismatch is None and len(got) == len(expected)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--host", default="localhost")
+    parser.add_argument("--ports", type=int, nargs=2, default=(3460, 3461),
+                        metavar=("CENTRAL", "PERIPHERAL"))
+    parser.add_argument("--serial", nargs=2, metavar=("CENTRAL", "PERIPHERAL"),
+                        help="real serial ports instead of Renode sockets")
+    parser.add_argument("--baud", type=int, default=1000000)
+    parser.add_argument("--bytes", type=int, default=16384,
+                        help="bytes sent in each direction")
+    parser.add_argument("--rate", type=float, default=0,
+                        help="bytes/s per direction, 0 for unpaced")
+    parser.add_argument("--idle", type=float, default=5.0,
+                        help="seconds without data before giving up")
+    args = parser.parse_args()
+
+    if args.serial:
+        central = SerialLink(args.serial[0], args.baud)
+        peripheral = SerialLink(args.serial[1], args.baud)
+    else:
+        central = SocketLink(args.host, args.ports[0])
+        peripheral = SocketLink(args.host, args.ports[1])
+
+    directions = [
+        Direction("central->peripheral", central, peripheral,
+                  pattern(0x11, args.bytes), args.rate, args.idle),
+        Direction("peripheral->central", peripheral, central,
+                  pattern(0x80, args.bytes), args.rate, args.idle),
+    ]
+
+    threads = []
+    for direction in directions:
+        threads.append(threading.Thread(target=direction.receive))
+        threads.append(threading.Thread(target=direction.send))
+    for thread in threads:
+        thread.start()
+    for thread in threads:
+        thread.join()
+
+    ok = all([direction.report() for direction in directions])
+    return 0 if ok else 1
+
+
+if __name__ == "__main__":
+    sys.exit(main())
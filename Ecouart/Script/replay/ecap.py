@@ -0,0 +1,280 @@
+#!/usr/bin/env python3
+"""Capture and replay of the Ecouart central data path.
+
+The central built with the `nrf52840_dk_capture` environment prints one `CAP:`
+line per data-path event on its console (`CAP:<type> <us since boot> <hex>`):
+`I` for a typed input line, `N` for a received notification, `C` for a
+connection (peer bt_addr_le_t) and `D` for a disconnection (reason). Grab that
+console on real hardware or from Renode and turn it into a btsnoop file (H4
+datalink), which Wireshark opens as ATT writes, ATT notifications and
+LE connection events:
+
+    python3 ecap.py convert central.log -o field.btsnoop
+    python3 ecap.py info field.btsnoop
+
+`replay` turns the input lines of a capture back into a Renode script that types
+them into the central's `uart0` with the original inter-arrival times, divided
+by `--speed`. Emulated time is used, so a replay is deterministic:
+
+    python3 ecap.py replay field.btsnoop -o out/replay.resc --speed 4
+    ./replay.sh field.btsnoop 4
+
+The first input is typed `--start` emulated seconds after reset, once the link
+is up; the rest keep their spacing relative to it. Inputs closer than `--min-gap`
+(the central's input task polls the console every 100 ms) are spread out and
+counted in the summary. Lines with CR or LF cannot go through console_getline
+and are skipped.
+"""
+
+import argparse
+import os
+import re
+import struct
+import sys
+
+# Lines cut or mixed with other console output are ignored.
+CAP_RE = re.compile(r"CAP:([INCD]) (\d+) ((?:[0-9a-f]{2})*)\r?$", re.M)
+
+BTSNOOP_MAGIC = b"btsnoop\0"
+BTSNOOP_VERSION = 1
+BTSNOOP_H4 = 1002
+# Microseconds between 0000-01-01 and 1970-01-01, the btsnoop time origin.
+BTSNOOP_EPOCH = 0x00DCDDB30F2F8000
+
+FLAG_RECEIVED = 0x01
+FLAG_EVENT = 0x02
+
+H4_ACL = 0x02
+H4_EVENT = 0x04
+CONN_HANDLE = 0x0001
+ATT_CID = 0x0004
+ATT_WRITE_CMD = 0x52
+ATT_NOTIFY = 0x1B
+
+
+def read_log(path):
+    """Returns [(type, us, payload)] from the CAP: lines of a console log."""
+    events = []
+    wrap = 0
+    last = 0
+    with open(path, errors="replace") as f:
+        for match in CAP_RE.finditer(f.read()):
+            kind, us, data = match.groups()
+            # The firmware prints a 32-bit microsecond counter.
+            us = int(us)
+            if us + wrap < last - (1 << 31):
+                wrap += 1 << 32
+            last = us + wrap
+            events.append((kind, last, bytes.fromhex(data)))
+    return events
+
+
+def acl(payload, opcode, received):
+    att = struct.pack("<BH", opcode, 0) + payload
+    l2cap = struct.pack("<HH", len(att), ATT_CID) + att
+    # Host to controller starts as non-flushable, controller to host as flushable.
+    flags = 0x2 if received else 0x0
+    return struct.pack("<BHH", H4_ACL, CONN_HANDLE | flags << 12, len(l2cap)) + l2cap
+
+
+def event(code, params):
+    return struct.pack("<BBB", H4_EVENT, code, len(params)) + params
+
+
+def encode(kind, payload):
+    """Returns (flags, H4 packet) for one capture event."""
+    if kind == "I":
+        return 0, acl(payload, ATT_WRITE_CMD, False)
+    if kind == "N":
+        return FLAG_RECEIVED, acl(payload, ATT_NOTIFY, True)
+    if kind == "C":
+        addr_type, addr = payload[0], payload[1:7]
+        # LE Connection Complete, central role; timing fields are not captured.
+        params = struct.pack("<BBHBB", 0x01, 0x00, CONN_HANDLE, 0x00, addr_type)
+        params += addr + struct.pack("<HHHB", 0, 0, 0, 0)
+        return FLAG_RECEIVED | FLAG_EVENT, event(0x3E, params)
+    reason = payload[0] if payload else 0
+    return FLAG_RECEIVED | FLAG_EVENT, event(0x05, struct.pack("<BHB", 0, CONN_HANDLE, reason))
+
+
+def decode(flags, packet):
+    """Returns (type, payload) for a packet written by encode(), or None."""
+    if packet[0] == H4_ACL and len(packet) >= 12:
+        opcode = packet[9]
+        if opcode == ATT_WRITE_CMD and not flags & FLAG_RECEIVED:
+            return "I", packet[12:]
+        if opcode == ATT_NOTIFY and flags & FLAG_RECEIVED:
+            return "N", packet[12:]
+    elif packet[0] == H4_EVENT and len(packet) >= 3:
+        if packet[1] == 0x3E and len(packet) >= 14 and packet[3] == 0x01:
+            return "C", packet[8:15]
+        if packet[1] == 0x05 and len(packet) >= 7:
+            return "D", packet[6:7]
+    return None
+
+
+def write_btsnoop(path, events):
+    with open(path, "wb") as f:
+        f.write(BTSNOOP_MAGIC + struct.pack(">II", BTSNOOP_VERSION, BTSNOOP_H4))
+        for kind, us, payload in events:
+            flags, packet = encode(kind, payload)
+            f.write(struct.pack(">IIIIq", len(packet), len(packet), flags, 0,
+                                BTSNOOP_EPOCH + us))
+            f.write(packet)
+
+
+def read_btsnoop(path):
+    """Returns [(type, us, payload)] from a btsnoop file."""
+    events = []
+    with open(path, "rb") as f:
+        header = f.read(16)
+        if header[:8] != BTSNOOP_MAGIC:
+            raise ValueError("%s: not a btsnoop file" % path)
+        if struct.unpack(">I", header[12:16])[0] != BTSNOOP_H4:
+            raise ValueError("%s: only the H4 datalink is supported" % path)
+        while True:
+            record = f.read(24)
+            if len(record) < 24:
+                break
+            _, incl_len, flags, _, ts = struct.unpack(">IIIIq", record)
+            decoded = decode(flags, f.read(incl_len))
+            if decoded:
+                events.append((decoded[0], ts - BTSNOOP_EPOCH, decoded[1]))
+    return events
+
+
+def stats(values):
+    if not values:
+        return "-"
+    values = sorted(values)
+    return "min %d  avg %d  p95 %d  max %d" % (
+        values[0], sum(values) // len(values),
+        values[min(len(values) - 1, len(values) * 95 // 100)], values[-1])
+
+
+def cmd_convert(args):
+    events = read_log(args.log)
+    if not events:
+        print("%s: no CAP: lines; was the central built with "
+              "nrf52840_dk_capture?" % args.log, file=sys.stderr)
+        return 1
+    write_btsnoop(args.output, events)
+    print("%d events written to %s" % (len(events), args.output))
+    return 0
+
+
+def cmd_info(args):
+    events = read_btsnoop(args.capture)
+    if not events:
+        print("%s: empty capture" % args.capture)
+        return 0
+
+    span = events[-1][1] - events[0][1]
+    print("%s: %d events over %.3f s" % (args.capture, len(events), span / 1e6))
+    for kind, name in (("I", "input"), ("N", "notify")):
+        selected = [e for e in events if e[0] == kind]
+        times = [e[1] for e in selected]
+        gaps = [(b - a) // 1000 for a, b in zip(times, times[1:])]
+        print("  %-10s %6d  bytes %8d" % (name, len(selected),
+                                         sum(len(e[2]) for e in selected)))
+        print("             size B   %s" % stats([len(e[2]) for e in selected]))
+        print("             gap ms   %s" % stats(gaps))
+    for kind, name in (("C", "connect"), ("D", "disconnect")):
+        print("  %-10s %6d" % (name, sum(1 for e in events if e[0] == kind)))
+    return 0
+
+
+def resc_string(text):
+    return text.replace("\\", "\\\\").replace('"', '\\"')
+
+
+def cmd_replay(args):
+    inputs = [e for e in read_btsnoop(args.capture) if e[0] == "I"]
+    skipped = [e for e in inputs if b"\r" in e[2] or b"\n" in e[2]]
+    inputs = [e for e in inputs if e not in skipped]
+    if not inputs:
+        print("%s: no replayable input lines" % args.capture, file=sys.stderr)
+        return 1
+
+    origin = inputs[0][1]
+    schedule = []
+    spread = 0
+    last = None
+    for _, us, payload in inputs:
+        at = args.start + (us - origin) / 1e6 / args.speed
+        if last is not None and at - last < args.min_gap:
+            at = last + args.min_gap
+            spread += 1
+        schedule.append((at, payload))
+        last = at
+
+    lines = [
+        ":name: Ecouart replay of %s" % os.path.basename(args.capture),
+        "",
+        "# Generated by ecap.py: %d input lines at %gx speed." % (len(schedule), args.speed),
+        "",
+        '$central_log?=$ORIGIN/central.log',
+        '$peripheral_log?=$ORIGIN/peripheral.log',
+        "",
+        "include @%s" % os.path.abspath(os.path.join(os.path.dirname(__file__), "..", "ecouart.resc")),
+        "",
+        'mach set "peripheral"',
+        "uart0 CreateFileBackend $peripheral_log true",
+        'mach set "central"',
+        "uart0 CreateFileBackend $central_log true",
+        "",
+    ]
+    now = 0.0
+    for at, payload in schedule:
+        lines.append('emulation RunFor "%.6f"' % (at - now))
+        lines.extend("sysbus.uart0 WriteChar 0x%02X" % b for b in payload + b"\r")
+        now = at
+    lines.append('emulation RunFor "%.6f"' % args.tail)
+
+    with open(args.output, "w") as f:
+        f.write("\n".join(lines) + "\n")
+
+    print("%d inputs over %.3f emulated s written to %s" % (
+        len(schedule), schedule[-1][0] + args.tail, args.output))
+    if spread:
+        print("  %d inputs delayed to keep %.3f s apart" % (spread, args.min_gap))
+    if skipped:
+        print("  %d inputs with CR/LF skipped" % len(skipped))
+    return 0
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    sub = parser.add_subparsers(dest="command", required=True)
+
+    convert = sub.add_parser("convert", help="console log with CAP: lines to btsnoop")
+    convert.add_argument("log")
+    convert.add_argument("-o", "--output", default="capture.btsnoop")
+    convert.set_defaults(func=cmd_convert)
+
+    info = sub.add_parser("info", help="event counts, sizes and inter-arrival times")
+    info.add_argument("capture")
+    info.set_defaults(func=cmd_info)
+
+    replay = sub.add_parser("replay", help="btsnoop to a Renode replay script")
+    replay.add_argument("capture")
+    replay.add_argument("-o", "--output", default="replay.resc")
+    replay.add_argument("--speed", type=float, default=1.0,
+                        help="time scale, 2 replays twice as fast (default 1)")
+    replay.add_argument("--start", type=float, default=3.0,
+                        help="emulated seconds before the first input (default 3)")
+    replay.add_argument("--min-gap", type=float, default=0.1,
+                        help="smallest spacing between inputs, in s (default 0.1)")
+    replay.add_argument("--tail", type=float, default=2.0,
+                        help="emulated seconds to run after the last input (default 2)")
+    replay.set_defaults(func=cmd_replay)
+
+    args = parser.parse_args()
+    if getattr(args, "speed", 1.0) <= 0:
+        parser.error("--speed must be positive")
+    return args.func(args)
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,40 @@
+#!/usr/bin/env bash
+#
+# Replays a capture into the Ecouart central under Renode.
+#
+# Record one with the capture build on the central, then convert its console:
+#   (cd Ecouart/Central && pio run -e nrf52840_dk_capture)
+#   python3 ecap.py convert central.log -o field.btsnoop
+#
+# Then:
+#   ./replay.sh field.btsnoop [speed] [central env]
+#
+# The central defaults to the capture build too, so the replayed run is itself
+# captured and summarised next to the original for comparison.
+
+set -euo pipefail
+
+HERE="$(cd "$(dirname "${BASH_SOURCE[0]}")" && pwd)"
+ROOT="${HERE}/../.."
+OUT="${HERE}/out"
+CAPTURE="${1:?usage: replay.sh <capture.btsnoop> [speed] [central env]}"
+SPEED="${2:-1}"
+CENTRAL_ENV="${3:-nrf52840_dk_capture}"
+RENODE="${RENODE:-renode}"
+
+rm -rf "${OUT}"
+mkdir -p "${OUT}"
+
+python3 "${HERE}/ecap.py" replay "${CAPTURE}" -o "${OUT}/replay.resc" \
+  --speed "${SPEED}"
+
+commands="\$central_bin=@${ROOT}/Central/.pio/build/${CENTRAL_ENV}/firmware.elf"
+commands+="; include @${OUT}/replay.resc; quit"
+
+"${RENODE}" --disable-xwt --console -e "${commands}"
+
+if grep -q "CAP:" "${OUT}/central.log"; then
+  python3 "${HERE}/ecap.py" convert "${OUT}/central.log" -o "${OUT}/replay.btsnoop"
+  python3 "${HERE}/ecap.py" info "${CAPTURE}"
+  python3 "${HERE}/ecap.py" info "${OUT}/replay.btsnoop"
+fi
@@ -0,0 +1,176 @@
+#!/usr/bin/env python3
+"""Scale-test scenario generator for Ecouart: one central versus N peripherals.
+
+`generate` writes a Renode script with one Ecouart central, N Ecouart
+peripherals and M non-UART advertisers (the Zephyr heart-rate peripheral used
+by the original demo) on the same BLE medium. Every machine gets its own
+FICR device address, so the identical peripheral images advertise as
+distinct devices.
+
+`sweep` generates one scenario per N, runs `scale.robot` on each with
+renode-test and prints connection success rate, scan-to-connect time and
+link throughput as N grows. The central holds one link, so the throughput is
+that link's, measured with lines sent back to back.
+
+    python3 scale_scenario.py generate -n 8 --noise 4 -o crowd.resc
+    python3 scale_scenario.py sweep -n 1 2 4 8 16 --noise 0 --trials 3
+"""
+
+import argparse
+import csv
+import os
+import statistics
+import subprocess
+import sys
+import tempfile
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+ECOUART = os.path.normpath(os.path.join(HERE, "..", ".."))
+CENTRAL_BIN = os.path.join(ECOUART, "Central/.pio/build/nrf52840_dk/firmware.elf")
+PERIPHERAL_BIN = os.path.join(
+    ECOUART, "Peripheral/.pio/build/nrf52840_dk/firmware.elf"
+)
+NOISE_BIN = (
+    "https://dl.antmicro.com/projects/renode/"
+    "nrf52840--zephyr-bluetooth_peripheral_hr.elf-s_3217940-"
+    "7b59adc9629f8be90067b131e663a13d2d4bb711"
+)
+
+# FICR DEVICEADDR[0] and DEVICEADDR[1], read by the Zephyr controller to
+# build the random static address.
+FICR_DEVICEADDR = (0x100000A4, 0x100000A8)
+
+
+def machine_block(name, platform="@platforms/cpus/nrf52840.repl"):
+    return (
+        'mach create "%s"\n'
+        "machine LoadPlatformDescription %s\n"
+        "connector Connect sysbus.radio wireless\n" % (name, platform)
+    )
+
+
+def load_block(name, binary, index):
+    # Two top bits set, as required for a random static address.
+    addr_lo = 0xEC0A0000 | index
+    addr_hi = 0xC000 | index
+    return (
+        '    mach set "%s"\n'
+        "    sysbus LoadELF %s\n"
+        "    sysbus WriteDoubleWord 0x%08X 0x%08X\n"
+        "    sysbus WriteDoubleWord 0x%08X 0x%08X\n"
+        % (name, binary, FICR_DEVICEADDR[0], addr_lo, FICR_DEVICEADDR[1], addr_hi)
+    )
+
+
+def generate(peripherals, noise, central_bin, peripheral_bin, noise_bin):
+    machines = [("central", "$central_bin")]
+    machines += [("peripheral_%d" % i, "$peripheral_bin") for i in range(peripherals)]
+    machines += [("noise_%d" % i, "$noise_bin") for i in range(noise)]
+
+    lines = [
+        ":name: Ecouart scale scenario (%d peripherals, %d noise advertisers)\n"
+        % (peripherals, noise),
+        "\n# Generated by scale_scenario.py, do not edit.\n",
+        "using sysbus\n\n",
+        "$central_bin?=@%s\n" % central_bin,
+        "$peripheral_bin?=@%s\n" % peripheral_bin,
+        "$noise_bin?=@%s\n\n" % noise_bin,
+        'emulation CreateBLEMedium "wireless"\n\n',
+    ]
+    lines += [machine_block(name) + "\n" for name, _ in machines]
+    lines += [
+        'emulation SetGlobalQuantum "0.00001"\n\n',
+        "macro reset\n",
+        '"""\n',
+    ]
+    lines += [
+        load_block(name, binary, index)
+        for index, (name, binary) in enumerate(machines)
+    ]
+    lines += [
+        '    mach set "central"\n',
+        '"""\n',
+        "runMacro $reset\n",
+    ]
+    return "".join(lines)
+
+
+def summarize(rows):
+    by_n = {}
+    for row in rows:
+        by_n.setdefault((int(row[0]), int(row[1])), []).append(row)
+
+    print("%5s %5s %7s %9s %9s %9s %10s" % (
+        "N", "noise", "trials", "success", "conn_avg", "conn_max", "thr_B/s"))
+    for (n, noise), trials in sorted(by_n.items()):
+        ok = [t for t in trials if t[3] == "1"]
+        conn = [float(t[4]) for t in ok]
+        thr = [float(t[5]) for t in ok]
+        print("%5d %5d %7d %8.0f%% %9s %9s %10s" % (
+            n, noise, len(trials), 100.0 * len(ok) / len(trials),
+            "%.0f" % statistics.mean(conn) if conn else "-",
+            "%.0f" % max(conn) if conn else "-",
+            "%.0f" % statistics.mean(thr) if thr else "-"))
+
+
+def cmd_generate(args):
+    script = generate(args.peripherals[0], args.noise, args.central_bin,
+                      args.peripheral_bin, args.noise_bin)
+    if args.output:
+        with open(args.output, "w") as f:
+            f.write(script)
+    else:
+        sys.stdout.write(script)
+    return 0
+
+
+def cmd_sweep(args):
+    out_dir = args.output or tempfile.mkdtemp(prefix="ecouart_scale_")
+    os.makedirs(out_dir, exist_ok=True)
+    metrics = os.path.join(out_dir, "scale_metrics.csv")
+    if os.path.exists(metrics):
+        os.remove(metrics)
+
+    for n in args.peripherals:
+        scenario = os.path.join(out_dir, "scale_%d_%d.resc" % (n, args.noise))
+        with open(scenario, "w") as f:
+            f.write(generate(n, args.noise, args.central_bin,
+                             args.peripheral_bin, args.noise_bin))
+        subprocess.call([
+            args.renode_test, os.path.join(HERE, "scale.robot"),
+            "--variable", "SCENARIO:%s" % scenario,
+            "--variable", "PERIPHERALS:%d" % n,
+            "--variable", "NOISE:%d" % args.noise,
+            "--variable", "TRIALS:%d" % args.trials,
+            "--variable", "METRICS_FILE:%s" % metrics,
+            "--results-dir", os.path.join(out_dir, "results_%d" % n),
+        ])
+
+    if not os.path.exists(metrics):
+        print("no metrics collected, check renode-test output", file=sys.stderr)
+        return 1
+
+    with open(metrics) as f:
+        summarize(list(csv.reader(f)))
+    print("raw metrics: %s" % metrics)
+    return 0
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("mode", choices=("generate", "sweep"))
+    parser.add_argument("-n", "--peripherals", type=int, nargs="+", default=[1])
+    parser.add_argument("--noise", type=int, default=0)
+    parser.add_argument("--trials", type=int, default=3)
+    parser.add_argument("-o", "--output", help="scenario file or sweep directory")
+    parser.add_argument("--central-bin", default=CENTRAL_BIN)
+    parser.add_argument("--peripheral-bin", default=PERIPHERAL_BIN)
+    parser.add_argument("--noise-bin", default=NOISE_BIN)
+    parser.add_argument("--renode-test", default="renode-test")
+    args = parser.parse_args()
+
+    return cmd_generate(args) if args.mode == "generate" else cmd_sweep(args)
+
+
+if __name__ == "__main__":
+    sys.exit(main())
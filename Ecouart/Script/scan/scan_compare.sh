@@ -0,0 +1,65 @@
+#!/usr/bin/env bash
+#
+# Compares the central's scan policies under Renode: legacy (no scanning while
+# connected), fixed (fast background scanning while connected) and adaptive
+# (scan_sched picks the duty cycle from the link and queue state).
+#
+# Build the default images first:
+#   (cd Ecouart/Central && pio run -e nrf52840_dk)
+#   (cd Ecouart/Peripheral && pio run -e nrf52840_dk)
+#
+# Then:
+#   ./scan_compare.sh [burst lines]
+#
+# For each policy the central gets the policy over its console, waits for the
+# link, and receives a burst of lines with no input delay. `perf stats` then
+# reports the control lane throughput. The peripheral is reset afterwards, so
+# the central loses the link and the time to find the peripheral again is
+# measured as well.
+
+set -euo pipefail
+
+HERE="$(cd "$(dirname "${BASH_SOURCE[0]}")" && pwd)"
+OUT="${HERE}/out"
+LINES="${1:-40}"
+RENODE="${RENODE:-renode}"
+PAYLOAD="$(printf 'x%.0s' $(seq 1 100))"
+
+type_line() {
+  local line="$1"
+  local commands=""
+
+  for ((i = 0; i < ${#line}; i++)); do
+    commands+="; sysbus.uart0 WriteChar $(printf '0x%02X' "'${line:i:1}")"
+  done
+  echo "${commands}; sysbus.uart0 WriteChar 0x0D"
+}
+
+rm -rf "${OUT}"
+
+for policy in 0 1 2; do
+  mkdir -p "${OUT}/policy${policy}"
+
+  commands="\$central_log=@${OUT}/policy${policy}/central.log"
+  commands+="; \$peripheral_log=@${OUT}/policy${policy}/peripheral.log"
+  commands+="; include @${HERE}/scan.resc; mach set \"central\""
+  commands+="; emulation RunFor \"1.5\""
+  commands+="$(type_line "perf set scan_policy ${policy}")"
+  commands+="; emulation RunFor \"0.2\""
+  commands+="$(type_line "perf set input_sleep_ms 0")"
+  commands+="; emulation RunFor \"3\""
+  for ((n = 0; n < LINES; n++)); do
+    commands+="$(type_line "${PAYLOAD}")"
+    commands+="; emulation RunFor \"0.01\""
+  done
+  commands+="; emulation RunFor \"2\""
+  commands+="$(type_line "perf stats")"
+  commands+="; mach set \"peripheral\"; machine Reset; mach set \"central\""
+  commands+="; emulation RunFor \"10\""
+  commands+="$(type_line "perf stats")"
+  commands+="; emulation RunFor \"0.5\"; quit"
+
+  "${RENODE}" --disable-xwt --console -e "${commands}"
+done
+
+python3 "${HERE}/scan_report.py" "${OUT}"/policy*
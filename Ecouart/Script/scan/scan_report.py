@@ -0,0 +1,61 @@
+#!/usr/bin/env python3
+"""Scan policy report for the Ecouart central.
+
+Reads the central.log written by scan_compare.sh for each policy. Prints the
+control lane throughput and latency of the burst, taken from the first
+`perf stats`, and the rediscovery time after the peripheral reset, taken from
+the last `|SCAN|` summary, together with the time spent in each scan mode.
+
+    python3 scan_report.py out/policy0 out/policy1 out/policy2
+"""
+
+import os
+import re
+import sys
+
+POLICIES = {"policy0": "legacy", "policy1": "fixed", "policy2": "adaptive"}
+MODES = ("off", "boost", "fast", "slow", "passive", "paused")
+QOS_RE = re.compile(r"\|QOS\| control .*?lat_avg_us=(\d+) lat_max_us=(\d+) rate=(\d+) B/s")
+SCAN_RE = re.compile(r"\|SCAN\| mode=\w+ switches=(\d+) errors=\d+ discoveries=(\d+) "
+                     r"discovery_last_ms=(\d+)")
+MODE_RE = re.compile(r"\|SCAN\| (\w+)_ms=(-?\d+)")
+
+
+def read_run(path):
+    with open(os.path.join(path, "central.log"), errors="replace") as f:
+        text = f.read()
+
+    run = {}
+    qos = QOS_RE.search(text)
+    if qos:
+        run["lat_avg_us"], run["lat_max_us"], run["rate"] = map(int, qos.groups())
+    scans = SCAN_RE.findall(text)
+    if scans:
+        run["switches"], run["discoveries"], run["rediscovery_ms"] = map(int, scans[-1])
+    # Only the residency of the last summary, which covers the whole run.
+    modes = MODE_RE.findall(text)[-len(MODES):]
+    run["modes"] = {mode: int(ms) for mode, ms in modes}
+    return run
+
+
+def main():
+    if len(sys.argv) < 2:
+        print(__doc__.strip(), file=sys.stderr)
+        return 2
+
+    print("%-10s %10s %11s %11s %15s %9s  %s" % (
+        "policy", "rate B/s", "lat avg us", "lat max us", "rediscovery ms",
+        "switches", "  ".join("%7s" % m for m in MODES)))
+    for path in sys.argv[1:]:
+        name = os.path.basename(os.path.normpath(path))
+        run = read_run(path)
+        print("%-10s %10s %11s %11s %15s %9s  %s" % (
+            POLICIES.get(name, name), run.get("rate", "-"), run.get("lat_avg_us", "-"),
+            run.get("lat_max_us", "-"), run.get("rediscovery_ms", "-"),
+            run.get("switches", "-"),
+            "  ".join("%7s" % run["modes"].get(m, "-") for m in MODES)))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
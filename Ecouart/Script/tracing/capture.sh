@@ -0,0 +1,52 @@
+#!/usr/bin/env bash
+#
+# Captures CTF traces of both Ecouart firmwares under Renode.
+#
+# Build the tracing images first:
+#   (cd Ecouart/Central && pio run -e nrf52840_dk_tracing)
+#   (cd Ecouart/Peripheral && pio run -e nrf52840_dk_tracing)
+#
+# Then:
+#   ZEPHYR_BASE=~/zephyrproject/zephyr ./capture.sh [virtual seconds] [console line...]
+#
+# Each machine gets a CTF trace directory in out/<machine> with the Zephyr
+# metadata plus the Ecouart markers (ecouart.tsdl). Open them in Trace Compass
+# or print them with `babeltrace out/central`. Lines given after the duration
+# are typed into the central's console once it is subscribed.
+
+set -euo pipefail
+
+: "${ZEPHYR_BASE:?set ZEPHYR_BASE to the Zephyr tree the firmwares were built with}"
+
+HERE="$(cd "$(dirname "${BASH_SOURCE[0]}")" && pwd)"
+OUT="${HERE}/out"
+SECONDS_TO_RUN="${1:-10}"
+shift || true
+RENODE="${RENODE:-renode}"
+
+rm -rf "${OUT}"
+mkdir -p "${OUT}/central" "${OUT}/peripheral"
+
+# Types each console line into the central after the link is up.
+commands="include @${HERE}/trace.resc; mach set \"central\"; start"
+commands+="; emulation RunFor \"${SECONDS_TO_RUN}\""
+for line in "$@"; do
+  for ((i = 0; i < ${#line}; i++)); do
+    commands+="; sysbus.uart0 WriteChar $(printf '0x%02X' "'${line:i:1}")"
+  done
+  commands+="; sysbus.uart0 WriteChar 0x0D; emulation RunFor \"1\""
+done
+commands+="; quit"
+
+"${RENODE}" --disable-xwt --console -e "${commands}"
+
+for machine in central peripheral; do
+  cat "${ZEPHYR_BASE}/subsys/tracing/ctf/tsdl/metadata" "${HERE}/ecouart.tsdl" \
+    > "${OUT}/${machine}/metadata"
+  echo "${machine}: $(stat -c %s "${OUT}/${machine}/channel0_0") bytes of CTF"
+done
+
+if command -v babeltrace > /dev/null; then
+  babeltrace "${OUT}/central" | grep -c ecouart_marker \
+    | xargs echo "central markers:"
+fi
@@ -0,0 +1,68 @@
+#!/usr/bin/env bash
+#
+# Builds the Ecouart Central and Peripheral for the nrf52_bsim board and runs
+# them as two Linux processes connected by the BabbleSim 2.4 GHz phy.
+# The simulation runs as fast as the host allows, not in real time.
+#
+# Requires a Zephyr tree (ZEPHYR_BASE) and a BabbleSim build (BSIM_OUT_PATH,
+# BSIM_COMPONENTS_PATH), see the Zephyr nrf52_bsim board documentation.
+#
+#   ./run_bsim.sh                           # build and run for 60 s of sim time
+#   SIM_LENGTH=300e6 ./run_bsim.sh          # sim length in microseconds
+#   NO_BUILD=1 ./run_bsim.sh                # reuse the previous build
+#   WRAP="valgrind --tool=callgrind" ./run_bsim.sh
+#   WRAP="perf record -g -o central.perf" WRAP_ONLY=central ./run_bsim.sh
+#
+# The Central sends MESSAGE_RECEPTOR_SIM_MESSAGES generated lines once the link
+# is up. Logs go to build/central.log and build/peripheral.log.
+
+set -euo pipefail
+
+: "${ZEPHYR_BASE:?set ZEPHYR_BASE to the Zephyr tree}"
+: "${BSIM_OUT_PATH:?set BSIM_OUT_PATH to the BabbleSim output directory}"
+
+HERE="$(cd "$(dirname "${BASH_SOURCE[0]}")" && pwd)"
+BUILD="${BUILD:-${HERE}/build}"
+SIM_ID="${SIM_ID:-ecouart_$$}"
+SIM_LENGTH="${SIM_LENGTH:-60e6}"
+WRAP="${WRAP:-}"
+WRAP_ONLY="${WRAP_ONLY:-}"
+
+if [ -z "${NO_BUILD:-}" ]; then
+  west build -p auto -b nrf52_bsim -d "${BUILD}/central" "${HERE}/../Central/zephyr"
+  west build -p auto -b nrf52_bsim -d "${BUILD}/peripheral" "${HERE}/../Peripheral/zephyr"
+fi
+
+# Runs a device under ${WRAP}, or only the one named by ${WRAP_ONLY}.
+run_device() {
+  local name="$1" id="$2"
+  local wrap="${WRAP}"
+
+  if [ -n "${WRAP_ONLY}" ] && [ "${WRAP_ONLY}" != "${name}" ]; then
+    wrap=""
+  fi
+
+  ${wrap} "${BUILD}/${name}/zephyr/zephyr.exe" -s="${SIM_ID}" -d="${id}" \
+    > "${BUILD}/${name}.log" 2>&1
+}
+
+start=$(date +%s.%N)
+
+(cd "${BSIM_OUT_PATH}/bin" && ./bs_2G4_phy_v1 -s="${SIM_ID}" -D=2 \
+  -sim_length="${SIM_LENGTH}" > "${BUILD}/phy.log" 2>&1) &
+run_device central 0 &
+run_device peripheral 1 &
+wait
+
+end=$(date +%s.%N)
+
+sent=$(grep -c "Sending line:" "${BUILD}/central.log" || true)
+echoed=$(grep -c "Notification Received data:" "${BUILD}/central.log" || true)
+awk -v s="${start}" -v e="${end}" -v l="${SIM_LENGTH}" \
+  -v sent="${sent}" -v echoed="${echoed}" 'BEGIN {
+    wall = e - s; sim = l / 1e6;
+    printf("simulated %.1f s in %.1f s of wall time (%.1fx real time)\n",
+           sim, wall, sim / wall);
+    printf("lines sent %d, echoes received %d\n", sent, echoed);
+  }'
+grep "Simulated input done" "${BUILD}/central.log" || true
@@ -4,6 +4,8 @@
 #include <version.h>
 #include <zephyr.h>
 
+#include "cmdlink.h"
+
 #define GO_MSG "Go"
 #define TIMEOUT_MSG "Timeout"
 #define STOP_MSG "Stop"
@@ -110,6 +112,76 @@ tState HandleEventTimeout(tState currentState) {
   return new_state;
 }
 
+typedef enum {
+  kCmdGo = 1,
+  kCmdStop = 2,
+  kCmdTimeout = 3,
+  kCmdGetState = 4,
+  amount_cmds
+} tCommand;
+
+// Current state, shared by the console loop and the binary command channel
+static tState currentState = kGreenState;
+static K_MUTEX_DEFINE(stateLock);
+
+typedef tState (*tEventHandler)(tState currentState);
+
+// Runs an event handler under the state lock and returns the new state
+static tState DispatchEvent(tEventHandler handler) {
+  tState new_state;
+
+  k_mutex_lock(&stateLock, K_FOREVER);
+  currentState = handler(currentState);
+  new_state = currentState;
+  k_mutex_unlock(&stateLock);
+
+  return new_state;
+}
+
+// Builds the reply of the binary commands: current state and its light
+static enum cmdlink_status ReplyState(tState state, uint8_t *reply,
+                                      size_t *reply_len) {
+  reply[0] = state;
+  reply[1] = stateTable[state].light;
+  *reply_len = 2;
+  return CMDLINK_STATUS_OK;
+}
+
+static enum cmdlink_status HandleCmdGo(const struct cmdlink_view *payload,
+                                       uint8_t *reply, size_t *reply_len) {
+  return ReplyState(DispatchEvent(HandleEventGo), reply, reply_len);
+}
+
+static enum cmdlink_status HandleCmdStop(const struct cmdlink_view *payload,
+                                         uint8_t *reply, size_t *reply_len) {
+  return ReplyState(DispatchEvent(HandleEventStop), reply, reply_len);
+}
+
+static enum cmdlink_status
+HandleCmdTimeout(const struct cmdlink_view *payload, uint8_t *reply,
+                 size_t *reply_len) {
+  return ReplyState(DispatchEvent(HandleEventTimeout), reply, reply_len);
+}
+
+static enum cmdlink_status
+HandleCmdGetState(const struct cmdlink_view *payload, uint8_t *reply,
+                  size_t *reply_len) {
+  tState state;
+
+  k_mutex_lock(&stateLock, K_FOREVER);
+  state = currentState;
+  k_mutex_unlock(&stateLock);
+
+  return ReplyState(state, reply, reply_len);
+}
+
+static const cmdlink_handler_t commandTable[] = {
+    [kCmdGo] = HandleCmdGo,
+    [kCmdStop] = HandleCmdStop,
+    [kCmdTimeout] = HandleCmdTimeout,
+    [kCmdGetState] = HandleCmdGetState,
+};
+
 void main(void) {
   printk("Hello! I'm using Zephyr %s on %s, a %s board. \n\n",
          KERNEL_VERSION_STRING, CONFIG_BOARD, CONFIG_ARCH);
@@ -117,27 +189,30 @@ void main(void) {
   console_getline_init();
   printk("Enter a line finishing with Enter:\n");
 
-  tState currentState = kGreenState;
   LightOn(kGreenLight);
   LightOff(kRedLight);
   LightOff(kYellowLight);
 
+  if (cmdlink_init(commandTable, ARRAY_SIZE(commandTable))) {
+    printk("Binary command channel disabled.\n");
+  }
+
   while (1) {
     printk("Type an event (Go, Stop, Timeout) > ");
     char *s = console_getline();
 
     if (!strcmp(s, GO_MSG)) {
-      currentState = HandleEventGo(currentState);
+      DispatchEvent(HandleEventGo);
       continue;
     }
 
     if (!strcmp(s, TIMEOUT_MSG)) {
-      currentState = HandleEventTimeout(currentState);
+      DispatchEvent(HandleEventTimeout);
       continue;
     }
 
     if (!strcmp(s, STOP_MSG)) {
-      currentState = HandleEventStop(currentState);
+      DispatchEvent(HandleEventStop);
       continue;
     }
   }
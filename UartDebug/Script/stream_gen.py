@@ -0,0 +1,155 @@
+#!/usr/bin/env python3
+"""Host-side stream generator for the UartDebug echo benchmark.
+
+Connects to the firmware console (Renode socket terminal or a real serial
+port), starts a sweep or a single echo window and, for every READY marker,
+waits for the firmware's GO line (sent once it has settled and reset its
+buffers) and streams a known pattern while checking the echoed bytes. Prints the firmware
+RESULT lines together with the host-side view of the same window.
+
+    python3 stream_gen.py                       # Renode, socket://localhost:1234
+    python3 stream_gen.py --serial /dev/ttyUSB0 # real board (needs pyserial)
+    python3 stream_gen.py --command "echo 5000 256"
+"""
+
+import argparse
+import re
+import socket
+import sys
+import time
+
+PATTERN = bytes(range(ord("a"), ord("z") + 1))
+READY_RE = re.compile(rb"READY baud=(\d+) buf=(\d+) ms=(\d+)")
+RESULT_RE = re.compile(rb"RESULT [^\r\n]*")
+DONE_RE = re.compile(rb"DONE baud=(\d+)")
+GO_RE = re.compile(rb"(?m)^GO\r?\n")
+EVENT_RE = re.compile(READY_RE.pattern + b"|" + DONE_RE.pattern)
+
+
+class SocketLink:
+    def __init__(self, host, port):
+        self.sock = socket.create_connection((host, port))
+        self.sock.setblocking(False)
+
+    def write(self, data):
+        self.sock.sendall(data)
+
+    def read(self):
+        try:
+            return self.sock.recv(65536)
+        except BlockingIOError:
+            return b""
+
+    def set_baudrate(self, baudrate):
+        # Renode's socket terminal has no notion of baud rate.
+        pass
+
+
+class SerialLink:
+    def __init__(self, port, baudrate):
+        import serial
+
+        self.port = serial.Serial(port, baudrate, timeout=0)
+
+    def write(self, data):
+        self.port.write(data)
+
+    def read(self):
+        return self.port.read(65536)
+
+    def set_baudrate(self, baudrate):
+        self.port.baudrate = baudrate
+
+
+def wait_for(link, pattern, buf, timeout):
+    deadline = time.monotonic() + timeout
+    while time.monotonic() < deadline:
+        match = pattern.search(buf)
+        if match:
+            return match, buf[match.end():]
+        buf += link.read()
+        time.sleep(0.001)
+    return None, buf
+
+
+def run_window(link, baudrate, window_ms, rate, buf):
+    """Streams the pattern from GO until the firmware reports RESULT."""
+    link.set_baudrate(baudrate)
+    # Bytes sent before GO would be dropped by the firmware's reset but
+    # still counted as sent here.
+    go, buf = wait_for(link, GO_RE, buf, 5.0)
+    if not go:
+        print("timeout waiting for GO", file=sys.stderr)
+        return buf
+    # 10 bits per byte on the wire; --rate scales the offered load.
+    bytes_per_sec = baudrate / 10.0 * rate
+    sent = 0
+    echoed = buf
+    start = time.monotonic()
+    deadline = start + window_ms / 1000.0 + 5.0
+
+    while time.monotonic() < deadline:
+        elapsed = time.monotonic() - start
+        due = int(elapsed * bytes_per_sec) - sent
+        if due > 0 and elapsed < window_ms / 1000.0:
+            chunk = (PATTERN * (due // len(PATTERN) + 1))[:due]
+            link.write(chunk)
+            sent += due
+        echoed += link.read()
+        if RESULT_RE.search(echoed):
+            break
+        time.sleep(0.0005)
+
+    elapsed = time.monotonic() - start
+    result = RESULT_RE.search(echoed)
+    payload = echoed[: result.start()] if result else echoed
+    payload = payload.replace(b"\r", b"").replace(b"\n", b"")
+    corrupt = sum(1 for b in payload if b not in PATTERN)
+    print(
+        "host baud=%d sent=%d echoed=%d corrupt=%d host_Bps=%d"
+        % (baudrate, sent, len(payload), corrupt, len(payload) / elapsed)
+    )
+    if result:
+        print(result.group(0).decode())
+    rest = echoed[result.end():] if result else b""
+    return rest
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--host", default="localhost")
+    parser.add_argument("--port", type=int, default=1234)
+    parser.add_argument("--serial", help="serial device instead of a socket")
+    parser.add_argument("--baudrate", type=int, default=115200)
+    parser.add_argument("--command", default="sweep")
+    parser.add_argument(
+        "--rate", type=float, default=1.0, help="offered load relative to baud/10"
+    )
+    args = parser.parse_args()
+
+    if args.serial:
+        link = SerialLink(args.serial, args.baudrate)
+    else:
+        link = SocketLink(args.host, args.port)
+
+    link.write(args.command.encode() + b"\r")
+    buf = b""
+    while True:
+        event, buf = wait_for(link, EVENT_RE, buf, 10.0)
+        if not event:
+            print("timeout waiting for READY", file=sys.stderr)
+            return 1
+        done = DONE_RE.match(event.group(0))
+        if done:
+            link.set_baudrate(int(done.group(1)))
+            return 0
+        baudrate, buf_size, window_ms = (
+            int(g) for g in READY_RE.match(event.group(0)).groups()
+        )
+        print("window baud=%d buf=%d ms=%d" % (baudrate, buf_size, window_ms))
+        buf = run_window(link, baudrate, window_ms, args.rate, buf)
+        if args.command != "sweep":
+            return 0
+
+if __name__ == "__main__":
+    sys.exit(main())
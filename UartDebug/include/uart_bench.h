@@ -0,0 +1,112 @@
+/**
+ * @file uart_bench.h
+ * @brief Interface da ferramenta de desempenho da UART: eco por interrupção
+ * com ring buffers e varredura de baud rates e tamanhos de buffer.
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef UART_BENCH_H_
+#define UART_BENCH_H_
+
+#include <device.h>
+#include <drivers/uart.h>
+#include <sys/printk.h>
+#include <sys/ring_buffer.h>
+#include <zephyr.h>
+
+#include "stdint.h"
+#include "string.h"
+
+/**
+ * @brief Tamanho máximo dos ring buffers de RX e TX, em bytes.
+ *
+ */
+#define UART_BENCH_MAX_BUF_SIZE 1024
+
+/**
+ * @brief Tamanho máximo de uma linha de comando.
+ *
+ */
+#define UART_BENCH_LINE_MAX 64
+
+/**
+ * @brief Duração padrão de cada janela de medição, em milissegundos.
+ *
+ */
+#define UART_BENCH_WINDOW_MS 2000
+
+/**
+ * @brief Intervalo, em bytes aceitos, entre amostras de latência.
+ *
+ */
+#define UART_BENCH_LAT_SAMPLE_EVERY 64
+
+/**
+ * @brief Resultado de uma janela de medição.
+ *
+ */
+struct uart_bench_result {
+  uint32_t baudrate;      /* Baud rate efetivo da janela. */
+  uint32_t buf_size;      /* Tamanho dos ring buffers usados. */
+  uint32_t window_ms;     /* Duração real da janela. */
+  uint32_t rx_bytes;      /* Bytes lidos da FIFO de RX. */
+  uint32_t tx_bytes;      /* Bytes escritos na FIFO de TX. */
+  uint32_t dropped;       /* Bytes descartados por ring buffer cheio. */
+  uint32_t uart_errors;   /* Erros reportados pelo driver (overrun etc). */
+  uint32_t bytes_per_sec; /* Vazão sustentada do eco. */
+  uint32_t lat_samples;   /* Quantidade de amostras de latência. */
+  uint32_t lat_avg_us;    /* Latência média por byte. */
+  uint32_t lat_max_us;    /* Latência máxima por byte. */
+};
+
+/**
+ * @brief Inicializa a UART do console em modo por interrupção.
+ *
+ * @return int 0 para sucesso e um inteiro negativo em caso de falha.
+ */
+int uart_bench_init(void);
+
+/**
+ * @brief Lê uma linha de comando digitada na UART, sem o terminador.
+ *
+ * @return char* Ponteiro para buffer interno com a linha lida.
+ */
+char *uart_bench_getline(void);
+
+/**
+ * @brief Executa uma janela de eco com a configuração informada. A linha GO
+ * marca o início da janela: bytes recebidos antes dela são descartados no
+ * reinício dos buffers.
+ *
+ * @param baudrate Baud rate a aplicar, ou 0 para manter o atual.
+ * @param buf_size Tamanho dos ring buffers, até UART_BENCH_MAX_BUF_SIZE.
+ * @param window_ms Duração da janela de medição.
+ * @param result [out] Ponteiro para estrutura que recebe o resultado.
+ * @return int 0 para sucesso e um inteiro negativo em caso de falha.
+ */
+int uart_bench_run(uint32_t baudrate, uint32_t buf_size, uint32_t window_ms,
+                   struct uart_bench_result *result);
+
+/**
+ * @brief Executa uma única janela de eco anunciada com READY e imprime seu
+ * resultado em uma linha RESULT.
+ *
+ * @param window_ms Duração da janela de medição.
+ * @param buf_size Tamanho dos ring buffers.
+ * @param baudrate Baud rate a aplicar, ou 0 para manter o atual.
+ */
+void uart_bench_window(uint32_t window_ms, uint32_t buf_size,
+                       uint32_t baudrate);
+
+/**
+ * @brief Executa a varredura completa de baud rates e tamanhos de buffer,
+ * imprimindo uma linha RESULT por combinação.
+ *
+ */
+void uart_bench_sweep(void);
+
+#endif /* UART_BENCH_H_ */
@@ -1,21 +1,106 @@
-#include <console/console.h>
+#include <stdlib.h>
 #include <string.h>
+#include <sys/byteorder.h>
 #include <sys/printk.h>
 #include <version.h>
 #include <zephyr.h>
 
+#include "cmdlink.h"
+#include "uart_bench.h"
+
+#define SWEEP_MSG "sweep"
+#define ECHO_MSG "echo"
+
+typedef enum {
+  kCmdPing = 1,
+  kCmdEcho = 2,
+  kCmdStats = 3,
+  amount_cmds
+} tCommand;
+
+// Replies with an empty payload, used to measure round trips
+static enum cmdlink_status HandleCmdPing(const struct cmdlink_view *payload,
+                                         uint8_t *reply, size_t *reply_len) {
+  return CMDLINK_STATUS_OK;
+}
+
+// Replies with the received payload
+static enum cmdlink_status HandleCmdEcho(const struct cmdlink_view *payload,
+                                         uint8_t *reply, size_t *reply_len) {
+  if (payload->len > CMDLINK_MAX_REPLY) {
+    return CMDLINK_STATUS_BAD_PAYLOAD;
+  }
+
+  memcpy(reply, payload->data, payload->len);
+  *reply_len = payload->len;
+  return CMDLINK_STATUS_OK;
+}
+
+// Replies with the channel counters as little-endian uint32 values
+static enum cmdlink_status HandleCmdStats(const struct cmdlink_view *payload,
+                                          uint8_t *reply, size_t *reply_len) {
+  struct cmdlink_stats stats;
+
+  cmdlink_get_stats(&stats);
+  sys_put_le32(stats.frames, &reply[0]);
+  sys_put_le32(stats.crc_errors, &reply[4]);
+  sys_put_le32(stats.bad_frames, &reply[8]);
+  sys_put_le32(stats.unknown, &reply[12]);
+  sys_put_le32(stats.rx_dropped, &reply[16]);
+  sys_put_le32(stats.tx_bytes, &reply[20]);
+  *reply_len = 24;
+  return CMDLINK_STATUS_OK;
+}
+
+static const cmdlink_handler_t commandTable[] = {
+    [kCmdPing] = HandleCmdPing,
+    [kCmdEcho] = HandleCmdEcho,
+    [kCmdStats] = HandleCmdStats,
+};
+
+// Parses "echo [ms] [buf] [baud]" and runs a single measurement window
+static void HandleEcho(char *args) {
+  char *next = args;
+  uint32_t window_ms = strtoul(next, &next, 10);
+  uint32_t buf_size = strtoul(next, &next, 10);
+  uint32_t baudrate = strtoul(next, &next, 10);
+
+  uart_bench_window(window_ms ? window_ms : UART_BENCH_WINDOW_MS,
+                    buf_size ? buf_size : UART_BENCH_MAX_BUF_SIZE, baudrate);
+}
+
 void main(void) {
   printk("Hello! I'm using Zephyr %s on %s, a %s board. \n\n",
          KERNEL_VERSION_STRING, CONFIG_BOARD, CONFIG_ARCH);
 
-  console_getline_init();
+  if (uart_bench_init()) {
+    return;
+  }
+
+  if (cmdlink_init(commandTable, ARRAY_SIZE(commandTable))) {
+    printk("Binary command channel disabled.\n");
+  }
+
+  printk("Commands: %s | %s [ms] [buf] [baud]\n", SWEEP_MSG, ECHO_MSG);
   printk("Enter al line finishing with Enter:\n");
 
   while (1) {
     printk(">");
-    char *s = console_getline();
+    char *s = uart_bench_getline();
+
+    if (!strcmp(s, SWEEP_MSG)) {
+      uart_bench_sweep();
+      continue;
+    }
+
+    if (!strncmp(s, ECHO_MSG, strlen(ECHO_MSG))) {
+      HandleEcho(s + strlen(ECHO_MSG));
+      continue;
+    }
 
     printk("Typed line: %s\n", s);
-    printk("Last char was: 0x%x\n", s[strlen(s) - 1]);
+    if (strlen(s) > 0) {
+      printk("Last char was: 0x%x\n", s[strlen(s) - 1]);
+    }
   }
 }
\ No newline at end of file
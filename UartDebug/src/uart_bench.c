@@ -0,0 +1,485 @@
+/**
+ * @file uart_bench.c
+ * @brief Implementação da ferramenta de desempenho da UART: eco por
+ * interrupção com ring buffers e varredura de baud rates e tamanhos de buffer.
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "uart_bench.h"
+
+/**
+ * @brief Quantidade de amostras de latência em trânsito. Deve cobrir os dois
+ * ring buffers cheios mais as FIFOs do hardware.
+ *
+ */
+#define UART_BENCH_LAT_SLOTS                                                   \
+  ((2 * UART_BENCH_MAX_BUF_SIZE / UART_BENCH_LAT_SAMPLE_EVERY) + 4)
+
+/**
+ * @brief Tempo dado ao host para trocar de baud rate entre janelas.
+ *
+ */
+#define UART_BENCH_SETTLE_MS 100
+
+/**
+ * @brief Tempo máximo de espera para esvaziar o TX ao fim de uma janela.
+ *
+ */
+#define UART_BENCH_DRAIN_MS 200
+
+/**
+ * @brief Baud rates percorridos pela varredura.
+ *
+ */
+static const uint32_t baudrates[] = {9600,   57600,  115200, 230400,
+                                     460800, 921600, 1000000};
+
+/**
+ * @brief Tamanhos de ring buffer percorridos pela varredura.
+ *
+ */
+static const uint32_t buf_sizes[] = {64, 256, UART_BENCH_MAX_BUF_SIZE};
+
+/**
+ * @brief Rotina de interrupção da UART, trata RX e TX.
+ *
+ * @param dev [in] Ponteiro para o dispositivo UART.
+ * @param user_data [in] Não utilizado.
+ */
+static void uart_bench_isr(const struct device *dev, void *user_data);
+
+/**
+ * @brief Insere bytes lidos da FIFO no ring buffer de RX, contabilizando
+ * descartes e registrando amostras de latência.
+ *
+ * @param data [in] Ponteiro para os bytes lidos.
+ * @param len Quantidade de bytes lidos.
+ */
+static void uart_bench_rx_push(const uint8_t *data, uint32_t len);
+
+/**
+ * @brief Preenche a FIFO de TX a partir do ring buffer de TX, fechando as
+ * amostras de latência dos bytes transmitidos.
+ *
+ * @param dev [in] Ponteiro para o dispositivo UART.
+ */
+static void uart_bench_tx_pull(const struct device *dev);
+
+/**
+ * @brief Move os bytes recebidos do ring buffer de RX para o de TX.
+ *
+ */
+static void uart_bench_echo(void);
+
+/**
+ * @brief Altera o baud rate da UART em tempo de execução.
+ *
+ * @param baudrate Novo baud rate.
+ * @return int 0 para sucesso, -ENOSYS/-ENOTSUP se o driver não suporta
+ * reconfiguração e um inteiro negativo em caso de falha.
+ */
+static int uart_bench_set_baudrate(uint32_t baudrate);
+
+/**
+ * @brief Verifica se o driver aceita reconfiguração em tempo de execução.
+ *
+ * @return true Se uart_configure é suportado.
+ * @return false Caso contrário.
+ */
+static bool uart_bench_can_reconfigure(void);
+
+/**
+ * @brief Retorna o baud rate efetivo da UART.
+ *
+ * @return uint32_t Baud rate atual.
+ */
+static uint32_t uart_bench_get_baudrate(void);
+
+/**
+ * @brief Imprime o resultado de uma janela em formato de linha única.
+ *
+ * @param result [in] Ponteiro para o resultado a imprimir.
+ */
+static void uart_bench_print(const struct uart_bench_result *result);
+
+/**
+ * @brief Estrutura interna de variáveis.
+ *
+ */
+static struct {
+  const struct device *uart;       /* UART do console. */
+  struct ring_buf rx_ring;         /* Ring de RX, produzido pela ISR. */
+  struct ring_buf tx_ring;         /* Ring de TX, consumido pela ISR. */
+  uint8_t rx_storage[UART_BENCH_MAX_BUF_SIZE]; /* Memória do RX. */
+  uint8_t tx_storage[UART_BENCH_MAX_BUF_SIZE]; /* Memória do TX. */
+  struct k_sem rx_sem;             /* Sinaliza chegada de bytes. */
+  char line[UART_BENCH_LINE_MAX];  /* Buffer da linha de comando. */
+  bool last_was_cr;                /* Último caractere foi '\r'. */
+  volatile uint32_t rx_bytes;      /* Bytes lidos da FIFO. */
+  volatile uint32_t rx_accepted;   /* Bytes aceitos no ring de RX. */
+  volatile uint32_t dropped;       /* Bytes descartados, ring cheio. */
+  volatile uint32_t uart_errors;   /* Erros reportados pelo driver. */
+  volatile uint32_t tx_bytes;      /* Bytes escritos na FIFO de TX. */
+  uint32_t lat_stamp[UART_BENCH_LAT_SLOTS]; /* Ciclo de chegada. */
+  uint64_t lat_sum_cyc;            /* Soma das latências, em ciclos. */
+  uint32_t lat_max_cyc;            /* Maior latência, em ciclos. */
+  uint32_t lat_samples;            /* Amostras de latência fechadas. */
+} self = {
+    .uart = DEVICE_DT_GET(DT_CHOSEN(zephyr_console)),
+    .last_was_cr = false,
+};
+
+static void uart_bench_rx_push(const uint8_t *data, uint32_t len) {
+  uint32_t before = self.rx_accepted;
+  uint32_t put = ring_buf_put(&self.rx_ring, data, len);
+  uint32_t now = k_cycle_get_32();
+
+  self.rx_bytes += len;
+  self.dropped += len - put;
+  self.rx_accepted = before + put;
+
+  /* Registra o instante de chegada de cada byte amostrado aceito. */
+  for (uint32_t n = ROUND_UP(before, UART_BENCH_LAT_SAMPLE_EVERY);
+       n < self.rx_accepted; n += UART_BENCH_LAT_SAMPLE_EVERY) {
+    self.lat_stamp[(n / UART_BENCH_LAT_SAMPLE_EVERY) % UART_BENCH_LAT_SLOTS] =
+        now;
+  }
+}
+
+static void uart_bench_tx_pull(const struct device *dev) {
+  uint8_t *data;
+  uint32_t len;
+  uint32_t before;
+  uint32_t now;
+  int sent;
+
+  len = ring_buf_get_claim(&self.tx_ring, &data, UART_BENCH_MAX_BUF_SIZE);
+  if (len == 0U) {
+    uart_irq_tx_disable(dev);
+    return;
+  }
+
+  sent = uart_fifo_fill(dev, data, len);
+  if (sent <= 0) {
+    ring_buf_get_finish(&self.tx_ring, 0);
+    return;
+  }
+
+  ring_buf_get_finish(&self.tx_ring, sent);
+
+  before = self.tx_bytes;
+  self.tx_bytes = before + sent;
+  now = k_cycle_get_32();
+
+  /* Fecha as amostras dos bytes que acabaram de ir para a FIFO. */
+  for (uint32_t n = ROUND_UP(before, UART_BENCH_LAT_SAMPLE_EVERY);
+       n < self.tx_bytes; n += UART_BENCH_LAT_SAMPLE_EVERY) {
+    uint32_t delta =
+        now - self.lat_stamp[(n / UART_BENCH_LAT_SAMPLE_EVERY) %
+                             UART_BENCH_LAT_SLOTS];
+
+    self.lat_sum_cyc += delta;
+    self.lat_max_cyc = MAX(self.lat_max_cyc, delta);
+    self.lat_samples++;
+  }
+}
+
+static void uart_bench_isr(const struct device *dev, void *user_data) {
+  uint8_t chunk[16];
+  int len;
+
+  ARG_UNUSED(user_data);
+
+  while (uart_irq_update(dev) && uart_irq_is_pending(dev)) {
+    if (uart_irq_rx_ready(dev)) {
+      len = uart_fifo_read(dev, chunk, sizeof(chunk));
+      if (len > 0) {
+        uart_bench_rx_push(chunk, len);
+        k_sem_give(&self.rx_sem);
+      }
+    }
+
+    if (uart_irq_tx_ready(dev)) {
+      uart_bench_tx_pull(dev);
+    }
+  }
+
+  if (uart_err_check(dev) > 0) {
+    self.uart_errors++;
+  }
+}
+
+static void uart_bench_echo(void) {
+  uint8_t *data;
+  uint32_t len;
+  uint32_t put;
+
+  /* Copia direto da região reservada do RX para o TX, sem buffer
+   * intermediário. */
+  len = ring_buf_get_claim(&self.rx_ring, &data,
+                           ring_buf_space_get(&self.tx_ring));
+  while (len > 0U) {
+    put = ring_buf_put(&self.tx_ring, data, len);
+    ring_buf_get_finish(&self.rx_ring, put);
+    if (put < len) {
+      break;
+    }
+
+    len = ring_buf_get_claim(&self.rx_ring, &data,
+                             ring_buf_space_get(&self.tx_ring));
+  }
+
+  uart_irq_tx_enable(self.uart);
+}
+
+static int uart_bench_set_baudrate(uint32_t baudrate) {
+  struct uart_config cfg;
+  int err = 0;
+
+  err = uart_config_get(self.uart, &cfg);
+  if (err) {
+    return err;
+  }
+
+  if (cfg.baudrate == baudrate) {
+    return 0;
+  }
+
+  cfg.baudrate = baudrate;
+  return uart_configure(self.uart, &cfg);
+}
+
+static bool uart_bench_can_reconfigure(void) {
+  struct uart_config cfg;
+  int err = 0;
+
+  err = uart_config_get(self.uart, &cfg);
+  if (err) {
+    return false;
+  }
+
+  err = uart_configure(self.uart, &cfg);
+
+  return (err != -ENOSYS && err != -ENOTSUP);
+}
+
+static uint32_t uart_bench_get_baudrate(void) {
+  struct uart_config cfg;
+
+  if (uart_config_get(self.uart, &cfg)) {
+    return DT_PROP(DT_CHOSEN(zephyr_console), current_speed);
+  }
+
+  return cfg.baudrate;
+}
+
+static void uart_bench_print(const struct uart_bench_result *result) {
+  printk("RESULT baud=%u buf=%u ms=%u rx=%u tx=%u drop=%u err=%u Bps=%u "
+         "lat_avg_us=%u lat_max_us=%u samples=%u\n",
+         result->baudrate, result->buf_size, result->window_ms,
+         result->rx_bytes, result->tx_bytes, result->dropped,
+         result->uart_errors, result->bytes_per_sec, result->lat_avg_us,
+         result->lat_max_us, result->lat_samples);
+}
+
+int uart_bench_init(void) {
+  if (!device_is_ready(self.uart)) {
+    printk("UART device not ready.\n");
+    return -ENODEV;
+  }
+
+  k_sem_init(&self.rx_sem, 0, 1);
+  ring_buf_init(&self.rx_ring, UART_BENCH_LINE_MAX, self.rx_storage);
+  ring_buf_init(&self.tx_ring, UART_BENCH_MAX_BUF_SIZE, self.tx_storage);
+
+  uart_irq_callback_user_data_set(self.uart, uart_bench_isr, NULL);
+  uart_irq_rx_enable(self.uart);
+
+  return 0;
+}
+
+char *uart_bench_getline(void) {
+  size_t len = 0;
+  uint8_t c;
+
+  while (true) {
+    if (ring_buf_get(&self.rx_ring, &c, 1) == 0U) {
+      k_sem_take(&self.rx_sem, K_FOREVER);
+      continue;
+    }
+
+    /* Trata "\r\n" como um único terminador. */
+    if (c == '\n' && self.last_was_cr) {
+      self.last_was_cr = false;
+      continue;
+    }
+
+    self.last_was_cr = (c == '\r');
+
+    if (c == '\r' || c == '\n') {
+      uart_poll_out(self.uart, '\n');
+      break;
+    }
+
+    /* No início da linha, backspace e DEL não têm o que apagar. */
+    if (c == '\b' || c == 0x7F) {
+      if (len > 0) {
+        len--;
+        printk("\b \b");
+      }
+      continue;
+    }
+
+    if (len < sizeof(self.line) - 1) {
+      self.line[len++] = c;
+      uart_poll_out(self.uart, c);
+    }
+  }
+
+  self.line[len] = '\0';
+
+  return self.line;
+}
+
+int uart_bench_run(uint32_t baudrate, uint32_t buf_size, uint32_t window_ms,
+                   struct uart_bench_result *result) {
+  int64_t start;
+  int64_t elapsed;
+  int err = 0;
+
+  if (buf_size == 0U || buf_size > UART_BENCH_MAX_BUF_SIZE ||
+      window_ms == 0U || result == NULL) {
+    return -EINVAL;
+  }
+
+  if (baudrate != 0U) {
+    err = uart_bench_set_baudrate(baudrate);
+    if (err && err != -ENOSYS && err != -ENOTSUP) {
+      return err;
+    }
+  }
+
+  /* Reinicia buffers e contadores com as interrupções desligadas. */
+  uart_irq_rx_disable(self.uart);
+  uart_irq_tx_disable(self.uart);
+
+  ring_buf_init(&self.rx_ring, buf_size, self.rx_storage);
+  ring_buf_init(&self.tx_ring, buf_size, self.tx_storage);
+  self.rx_bytes = 0;
+  self.rx_accepted = 0;
+  self.dropped = 0;
+  self.uart_errors = 0;
+  self.tx_bytes = 0;
+  self.lat_sum_cyc = 0;
+  self.lat_max_cyc = 0;
+  self.lat_samples = 0;
+  k_sem_reset(&self.rx_sem);
+
+  /* O host só envia após o GO, já com a nova baud rate e os buffers
+   * limpos; antes disso, o que chegasse seria descartado acima. */
+  uart_irq_rx_enable(self.uart);
+  printk("GO\n");
+  start = k_uptime_get();
+
+  while ((elapsed = k_uptime_get() - start) < window_ms) {
+    k_sem_take(&self.rx_sem, K_MSEC(10));
+    uart_bench_echo();
+  }
+
+  /* Encerra a recepção e espera o eco pendente sair. */
+  uart_irq_rx_disable(self.uart);
+  uart_bench_echo();
+  for (int i = 0; i < UART_BENCH_DRAIN_MS &&
+                  !ring_buf_is_empty(&self.tx_ring);
+       i++) {
+    k_msleep(1);
+  }
+
+  uart_irq_tx_disable(self.uart);
+
+  result->baudrate = uart_bench_get_baudrate();
+  result->buf_size = buf_size;
+  result->window_ms = (uint32_t)elapsed;
+  result->rx_bytes = self.rx_bytes;
+  result->tx_bytes = self.tx_bytes;
+  result->dropped = self.dropped;
+  result->uart_errors = self.uart_errors;
+  result->bytes_per_sec =
+      (uint32_t)(((uint64_t)self.tx_bytes * MSEC_PER_SEC) / elapsed);
+  result->lat_samples = self.lat_samples;
+  result->lat_avg_us =
+      self.lat_samples
+          ? k_cyc_to_us_floor32((uint32_t)(self.lat_sum_cyc /
+                                           self.lat_samples))
+          : 0;
+  result->lat_max_us = k_cyc_to_us_floor32(self.lat_max_cyc);
+
+  /* Volta ao modo de linha de comando. */
+  ring_buf_init(&self.rx_ring, UART_BENCH_LINE_MAX, self.rx_storage);
+  ring_buf_reset(&self.tx_ring);
+  k_sem_reset(&self.rx_sem);
+  uart_irq_rx_enable(self.uart);
+
+  return 0;
+}
+
+void uart_bench_sweep(void) {
+  struct uart_bench_result result;
+  uint32_t original = uart_bench_get_baudrate();
+  size_t steps = ARRAY_SIZE(baudrates);
+  int err = 0;
+
+  /* Sem reconfiguração em tempo de execução, basta uma janela por buffer. */
+  if (!uart_bench_can_reconfigure()) {
+    printk("Baud rate fixed at %u, sweeping buffer sizes only.\n", original);
+    steps = 1;
+  }
+
+  for (size_t b = 0; b < ARRAY_SIZE(buf_sizes); b++) {
+    for (size_t r = 0; r < steps; r++) {
+      uint32_t baud = (steps == 1) ? original : baudrates[r];
+
+      printk("READY baud=%u buf=%u ms=%u\n", baud, buf_sizes[b],
+             UART_BENCH_WINDOW_MS);
+      k_msleep(UART_BENCH_SETTLE_MS);
+
+      err = uart_bench_run(baud, buf_sizes[b], UART_BENCH_WINDOW_MS,
+                           &result);
+      if (err) {
+        printk("ERROR baud=%u buf=%u err=%d\n", baud, buf_sizes[b], err);
+        continue;
+      }
+
+      k_msleep(UART_BENCH_SETTLE_MS);
+      uart_bench_print(&result);
+    }
+  }
+
+  printk("DONE baud=%u\n", original);
+  k_msleep(UART_BENCH_SETTLE_MS);
+  uart_bench_set_baudrate(original);
+}
+
+void uart_bench_window(uint32_t window_ms, uint32_t buf_size,
+                       uint32_t baudrate) {
+  struct uart_bench_result result;
+  int err = 0;
+
+  printk("READY baud=%u buf=%u ms=%u\n",
+         baudrate ? baudrate : uart_bench_get_baudrate(), buf_size,
+         window_ms);
+  k_msleep(UART_BENCH_SETTLE_MS);
+
+  err = uart_bench_run(baudrate, buf_size, window_ms, &result);
+  if (err) {
+    printk("ERROR err=%d\n", err);
+    return;
+  }
+
+  k_msleep(UART_BENCH_SETTLE_MS);
+  uart_bench_print(&result);
+}
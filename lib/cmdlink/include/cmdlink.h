@@ -0,0 +1,101 @@
+/**
+ * @file cmdlink.h
+ * @brief Interface do canal de comandos binário sobre UART: quadros COBS com
+ * CRC16 recebidos por interrupção em ring buffer e despachados por tabela de
+ * identificadores de comando.
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef CMDLINK_H_
+#define CMDLINK_H_
+
+#include <device.h>
+#include <drivers/uart.h>
+#include <sys/printk.h>
+#include <sys/ring_buffer.h>
+#include <zephyr.h>
+
+#include "cmdlink_frame.h"
+#include "stdint.h"
+#include "string.h"
+
+/**
+ * @brief Tamanho do ring buffer de RX, em bytes.
+ *
+ */
+#define CMDLINK_RX_BUF_SIZE 1024
+
+/**
+ * @brief Tamanho do ring buffer de TX, em bytes.
+ *
+ */
+#define CMDLINK_TX_BUF_SIZE 1024
+
+/**
+ * @brief Tamanho da pilha da tarefa de despacho.
+ *
+ */
+#define CMDLINK_STACK_SIZE 1024
+
+/**
+ * @brief Prioridade da tarefa de despacho.
+ *
+ */
+#define CMDLINK_THREAD_PRIORITY 5
+
+/**
+ * @brief Tamanho máximo da resposta de um handler, descontado o byte de
+ * estado.
+ *
+ */
+#define CMDLINK_MAX_REPLY (CMDLINK_MAX_PAYLOAD - 1)
+
+/**
+ * @brief Handler de um comando.
+ *
+ * @param payload [in] Visão do payload recebido, válida só durante a chamada.
+ * @param reply [out] Buffer para o payload da resposta, com CMDLINK_MAX_REPLY
+ * bytes.
+ * @param reply_len [out] Tamanho do payload escrito em reply, iniciado em 0.
+ * @return enum cmdlink_status Estado devolvido ao cliente.
+ */
+typedef enum cmdlink_status (*cmdlink_handler_t)(
+    const struct cmdlink_view *payload, uint8_t *reply, size_t *reply_len);
+
+/**
+ * @brief Contadores do canal.
+ *
+ */
+struct cmdlink_stats {
+  uint32_t frames;      /* Quadros válidos despachados. */
+  uint32_t crc_errors;  /* Quadros com CRC inválido. */
+  uint32_t bad_frames;  /* Quadros com COBS inválido, curtos ou longos. */
+  uint32_t unknown;     /* Comandos sem handler na tabela. */
+  uint32_t rx_dropped;  /* Bytes descartados com o ring de RX cheio. */
+  uint32_t tx_bytes;    /* Bytes de resposta transmitidos. */
+};
+
+/**
+ * @brief Inicializa o canal na UART escolhida por `cmdlink,uart` no
+ * devicetree e inicia a tarefa de despacho.
+ *
+ * @param table [in] Tabela de handlers indexada pelo id do comando. Entradas
+ * NULL respondem CMDLINK_STATUS_UNKNOWN_CMD.
+ * @param table_len Quantidade de entradas da tabela, no máximo
+ * CMDLINK_REPLY_FLAG.
+ * @return int 0 para sucesso e um inteiro negativo em caso de falha.
+ */
+int cmdlink_init(const cmdlink_handler_t *table, size_t table_len);
+
+/**
+ * @brief Copia os contadores atuais do canal.
+ *
+ * @param stats [out] Ponteiro para estrutura que recebe os contadores.
+ */
+void cmdlink_get_stats(struct cmdlink_stats *stats);
+
+#endif /* CMDLINK_H_ */
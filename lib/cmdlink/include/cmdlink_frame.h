@@ -0,0 +1,160 @@
+/**
+ * @file cmdlink_frame.h
+ * @brief Codificação dos quadros do canal de comandos binário: COBS, CRC16 e
+ * cabeçalho de comando. Não depende do Zephyr, sendo compartilhado com os
+ * clientes do host.
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef CMDLINK_FRAME_H_
+#define CMDLINK_FRAME_H_
+
+#include "stddef.h"
+#include "stdint.h"
+
+/**
+ * @brief Delimitador de quadro. COBS garante que não aparece no conteúdo.
+ *
+ */
+#define CMDLINK_DELIMITER 0x00
+
+/**
+ * @brief Tamanho máximo do payload de um comando ou resposta.
+ *
+ */
+#define CMDLINK_MAX_PAYLOAD 240
+
+/**
+ * @brief Bytes de cabeçalho: identificador do comando e sequência.
+ *
+ */
+#define CMDLINK_HEADER_LEN 2
+
+/**
+ * @brief Bytes do CRC16 ao fim do quadro.
+ *
+ */
+#define CMDLINK_CRC_LEN 2
+
+/**
+ * @brief Tamanho máximo de um quadro antes da codificação COBS.
+ *
+ */
+#define CMDLINK_MAX_RAW                                                        \
+  (CMDLINK_HEADER_LEN + CMDLINK_MAX_PAYLOAD + CMDLINK_CRC_LEN)
+
+/**
+ * @brief Tamanho máximo de um buffer de n bytes após COBS, sem delimitador.
+ *
+ */
+#define CMDLINK_COBS_MAX(n) ((n) + ((n) / 254) + 1)
+
+/**
+ * @brief Tamanho máximo de um quadro na linha, incluindo o delimitador.
+ *
+ */
+#define CMDLINK_MAX_ENCODED (CMDLINK_COBS_MAX(CMDLINK_MAX_RAW) + 1)
+
+/**
+ * @brief Bit que marca um quadro como resposta ao comando de mesmo id.
+ *
+ */
+#define CMDLINK_REPLY_FLAG 0x80
+
+/**
+ * @brief Estados retornados no primeiro byte do payload das respostas.
+ *
+ */
+enum cmdlink_status {
+  CMDLINK_STATUS_OK = 0,
+  CMDLINK_STATUS_UNKNOWN_CMD = 1,
+  CMDLINK_STATUS_BAD_PAYLOAD = 2,
+  CMDLINK_STATUS_FAILED = 3,
+};
+
+/**
+ * @brief Visão sem cópia de uma região de um buffer.
+ *
+ */
+struct cmdlink_view {
+  const uint8_t *data; /* Início da região. */
+  size_t len;          /* Tamanho da região. */
+};
+
+/**
+ * @brief Quadro decodificado. O payload aponta para dentro do buffer que foi
+ * decodificado.
+ *
+ */
+struct cmdlink_frame {
+  uint8_t id;                  /* Identificador do comando. */
+  uint8_t seq;                 /* Sequência, repetida na resposta. */
+  struct cmdlink_view payload; /* Payload do comando. */
+};
+
+/**
+ * @brief Calcula o CRC16-CCITT (polinômio 0x1021).
+ *
+ * @param data [in] Ponteiro para os dados.
+ * @param len Tamanho dos dados.
+ * @param seed Valor inicial, 0xFFFF para um novo cálculo.
+ * @return uint16_t CRC calculado.
+ */
+uint16_t cmdlink_crc16(const uint8_t *data, size_t len, uint16_t seed);
+
+/**
+ * @brief Codifica um buffer em COBS, sem acrescentar o delimitador.
+ *
+ * @param src [in] Ponteiro para os dados originais.
+ * @param len Tamanho dos dados originais.
+ * @param dst [out] Destino com ao menos CMDLINK_COBS_MAX(len) bytes. Não pode
+ * se sobrepor a src.
+ * @return size_t Quantidade de bytes escritos em dst.
+ */
+size_t cmdlink_cobs_encode(const uint8_t *src, size_t len, uint8_t *dst);
+
+/**
+ * @brief Decodifica um buffer COBS, sem o delimitador. Pode ser feito no
+ * próprio buffer (dst == src).
+ *
+ * @param src [in] Ponteiro para os dados codificados.
+ * @param len Tamanho dos dados codificados.
+ * @param dst [out] Destino com ao menos len bytes.
+ * @return int Tamanho decodificado ou -1 se os dados forem inválidos.
+ */
+int cmdlink_cobs_decode(const uint8_t *src, size_t len, uint8_t *dst);
+
+/**
+ * @brief Monta um quadro na linha a partir de um buffer bruto cujo payload já
+ * foi escrito em raw + CMDLINK_HEADER_LEN.
+ *
+ * @param raw [in,out] Buffer com ao menos CMDLINK_MAX_RAW bytes. Cabeçalho e
+ * CRC são escritos nele.
+ * @param payload_len Tamanho do payload já presente no buffer.
+ * @param id Identificador do comando ou resposta.
+ * @param seq Sequência do quadro.
+ * @param out [out] Destino com ao menos CMDLINK_MAX_ENCODED bytes.
+ * @return size_t Tamanho do quadro em out, incluindo o delimitador, ou 0 se o
+ * payload exceder CMDLINK_MAX_PAYLOAD.
+ */
+size_t cmdlink_frame_encode(uint8_t *raw, size_t payload_len, uint8_t id,
+                            uint8_t seq, uint8_t *out);
+
+/**
+ * @brief Decodifica no próprio buffer um quadro recebido, sem o delimitador,
+ * e valida seu CRC.
+ *
+ * @param buf [in,out] Quadro codificado, sobrescrito pelo quadro bruto.
+ * @param len Tamanho do quadro codificado.
+ * @param frame [out] Quadro decodificado, apontando para dentro de buf.
+ * @return int 0 para sucesso, -1 para COBS inválido ou quadro curto e -2 para
+ * CRC inválido.
+ */
+int cmdlink_frame_decode(uint8_t *buf, size_t len,
+                         struct cmdlink_frame *frame);
+
+#endif /* CMDLINK_FRAME_H_ */
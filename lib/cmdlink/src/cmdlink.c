@@ -0,0 +1,264 @@
+/**
+ * @file cmdlink.c
+ * @brief Implementação do canal de comandos binário sobre UART.
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "cmdlink.h"
+
+#if DT_HAS_CHOSEN(cmdlink_uart)
+#define CMDLINK_UART_NODE DT_CHOSEN(cmdlink_uart)
+#else
+#define CMDLINK_UART_NODE DT_CHOSEN(zephyr_console)
+#endif
+
+/**
+ * @brief Rotina de interrupção da UART, trata RX e TX.
+ *
+ * @param dev [in] Ponteiro para o dispositivo UART.
+ * @param user_data [in] Não utilizado.
+ */
+static void cmdlink_isr(const struct device *dev, void *user_data);
+
+/**
+ * @brief Tarefa que separa os quadros do ring de RX e os despacha.
+ *
+ */
+static void cmdlink_task(void *p1, void *p2, void *p3);
+
+/**
+ * @brief Consome o ring de RX até esvaziá-lo, despachando cada quadro
+ * completo.
+ *
+ */
+static void cmdlink_process_rx(void);
+
+/**
+ * @brief Decodifica, valida e despacha um quadro, enviando a resposta.
+ *
+ * @param buf [in,out] Quadro codificado, decodificado no próprio buffer.
+ * @param len Tamanho do quadro codificado.
+ */
+static void cmdlink_handle_frame(uint8_t *buf, size_t len);
+
+/**
+ * @brief Enfileira um quadro codificado para transmissão, aguardando espaço
+ * no ring de TX.
+ *
+ * @param data [in] Ponteiro para o quadro codificado.
+ * @param len Tamanho do quadro codificado.
+ */
+static void cmdlink_tx(const uint8_t *data, size_t len);
+
+/**
+ * @brief Pilha da tarefa de despacho.
+ *
+ */
+K_THREAD_STACK_DEFINE(cmdlink_stack, CMDLINK_STACK_SIZE);
+
+/**
+ * @brief Estrutura interna de variáveis.
+ *
+ */
+static struct {
+  const struct device *uart;       /* UART do canal. */
+  const cmdlink_handler_t *table;  /* Tabela de handlers por id. */
+  size_t table_len;                /* Entradas da tabela. */
+  struct ring_buf rx_ring;         /* Ring de RX, produzido pela ISR. */
+  struct ring_buf tx_ring;         /* Ring de TX, consumido pela ISR. */
+  uint8_t rx_storage[CMDLINK_RX_BUF_SIZE]; /* Memória do RX. */
+  uint8_t tx_storage[CMDLINK_TX_BUF_SIZE]; /* Memória do TX. */
+  struct k_sem frame_sem;          /* Sinaliza delimitadores recebidos. */
+  uint8_t rx_frame[CMDLINK_MAX_ENCODED]; /* Quadro em montagem. */
+  size_t rx_len;                   /* Bytes no quadro em montagem. */
+  bool rx_overflow;                /* Quadro em montagem excedeu o máximo. */
+  uint8_t tx_raw[CMDLINK_MAX_RAW]; /* Resposta antes do COBS. */
+  uint8_t tx_frame[CMDLINK_MAX_ENCODED]; /* Resposta codificada. */
+  struct cmdlink_stats stats;      /* Contadores do canal. */
+  struct k_thread thread;          /* Tarefa de despacho. */
+} self = {
+    .uart = DEVICE_DT_GET(CMDLINK_UART_NODE),
+    .table = NULL,
+    .table_len = 0,
+    .rx_len = 0,
+    .rx_overflow = false,
+};
+
+static void cmdlink_isr(const struct device *dev, void *user_data) {
+  uint8_t chunk[16];
+  uint8_t *data;
+  uint32_t len;
+  uint32_t put;
+  int read;
+  int sent;
+
+  ARG_UNUSED(user_data);
+
+  while (uart_irq_update(dev) && uart_irq_is_pending(dev)) {
+    if (uart_irq_rx_ready(dev)) {
+      read = uart_fifo_read(dev, chunk, sizeof(chunk));
+      if (read > 0) {
+        put = ring_buf_put(&self.rx_ring, chunk, read);
+        self.stats.rx_dropped += read - put;
+
+        /* Só acorda a tarefa quando há um quadro completo. */
+        if (memchr(chunk, CMDLINK_DELIMITER, read) != NULL) {
+          k_sem_give(&self.frame_sem);
+        }
+      }
+    }
+
+    if (uart_irq_tx_ready(dev)) {
+      len = ring_buf_get_claim(&self.tx_ring, &data, CMDLINK_TX_BUF_SIZE);
+      if (len == 0U) {
+        uart_irq_tx_disable(dev);
+        continue;
+      }
+
+      sent = uart_fifo_fill(dev, data, len);
+      ring_buf_get_finish(&self.tx_ring, MAX(sent, 0));
+      self.stats.tx_bytes += MAX(sent, 0);
+    }
+  }
+}
+
+static void cmdlink_tx(const uint8_t *data, size_t len) {
+  uint32_t put;
+
+  while (len > 0) {
+    put = ring_buf_put(&self.tx_ring, data, len);
+    data += put;
+    len -= put;
+
+    uart_irq_tx_enable(self.uart);
+    if (len > 0) {
+      k_msleep(1);
+    }
+  }
+}
+
+static void cmdlink_handle_frame(uint8_t *buf, size_t len) {
+  struct cmdlink_frame frame;
+  enum cmdlink_status status;
+  uint8_t *reply = &self.tx_raw[CMDLINK_HEADER_LEN];
+  size_t reply_len = 0;
+  size_t out_len;
+  int err = 0;
+
+  err = cmdlink_frame_decode(buf, len, &frame);
+  if (err == -2) {
+    self.stats.crc_errors++;
+    return;
+  } else if (err) {
+    self.stats.bad_frames++;
+    return;
+  }
+
+  if (frame.id < self.table_len && self.table[frame.id] != NULL) {
+    /* O handler recebe uma visão do quadro e escreve direto na resposta. */
+    status = self.table[frame.id](&frame.payload, &reply[1], &reply_len);
+    self.stats.frames++;
+  } else {
+    status = CMDLINK_STATUS_UNKNOWN_CMD;
+    self.stats.unknown++;
+  }
+
+  if (status != CMDLINK_STATUS_OK || reply_len > CMDLINK_MAX_REPLY) {
+    reply_len = 0;
+  }
+
+  reply[0] = status;
+  out_len = cmdlink_frame_encode(self.tx_raw, reply_len + 1,
+                                 frame.id | CMDLINK_REPLY_FLAG, frame.seq,
+                                 self.tx_frame);
+
+  cmdlink_tx(self.tx_frame, out_len);
+}
+
+static void cmdlink_process_rx(void) {
+  uint8_t *data;
+  uint8_t *end;
+  uint32_t len;
+  uint32_t used;
+
+  while ((len = ring_buf_get_claim(&self.rx_ring, &data,
+                                   CMDLINK_RX_BUF_SIZE)) > 0) {
+    end = memchr(data, CMDLINK_DELIMITER, len);
+    used = end ? (uint32_t)(end - data) : len;
+
+    /* Acumula o trecho no quadro em montagem, descartando o excesso. */
+    if (self.rx_len + used <= sizeof(self.rx_frame)) {
+      memcpy(&self.rx_frame[self.rx_len], data, used);
+      self.rx_len += used;
+    } else {
+      self.rx_overflow = true;
+    }
+
+    ring_buf_get_finish(&self.rx_ring, end ? used + 1 : used);
+
+    if (end == NULL) {
+      continue;
+    }
+
+    if (self.rx_overflow) {
+      self.stats.bad_frames++;
+    } else if (self.rx_len > 0) {
+      cmdlink_handle_frame(self.rx_frame, self.rx_len);
+    }
+
+    self.rx_len = 0;
+    self.rx_overflow = false;
+  }
+}
+
+static void cmdlink_task(void *p1, void *p2, void *p3) {
+  ARG_UNUSED(p1);
+  ARG_UNUSED(p2);
+  ARG_UNUSED(p3);
+
+  while (true) {
+    k_sem_take(&self.frame_sem, K_FOREVER);
+    cmdlink_process_rx();
+  }
+}
+
+int cmdlink_init(const cmdlink_handler_t *table, size_t table_len) {
+  if (table == NULL || table_len > CMDLINK_REPLY_FLAG) {
+    return -EINVAL;
+  }
+
+  if (!device_is_ready(self.uart)) {
+    printk("|CMDLINK| UART device not ready.\n");
+    return -ENODEV;
+  }
+
+  self.table = table;
+  self.table_len = table_len;
+
+  k_sem_init(&self.frame_sem, 0, K_SEM_MAX_LIMIT);
+  ring_buf_init(&self.rx_ring, CMDLINK_RX_BUF_SIZE, self.rx_storage);
+  ring_buf_init(&self.tx_ring, CMDLINK_TX_BUF_SIZE, self.tx_storage);
+
+  uart_irq_callback_user_data_set(self.uart, cmdlink_isr, NULL);
+  uart_irq_rx_enable(self.uart);
+
+  k_thread_create(&self.thread, cmdlink_stack,
+                  K_THREAD_STACK_SIZEOF(cmdlink_stack), cmdlink_task, NULL,
+                  NULL, NULL, CMDLINK_THREAD_PRIORITY, 0, K_NO_WAIT);
+  k_thread_name_set(&self.thread, "cmdlink");
+
+  printk("|CMDLINK| Listening on %s.\n", self.uart->name);
+
+  return 0;
+}
+
+void cmdlink_get_stats(struct cmdlink_stats *stats) {
+  unsigned int key = irq_lock();
+
+  *stats = self.stats;
+  irq_unlock(key);
+}
@@ -0,0 +1,128 @@
+/**
+ * @file cmdlink_frame.c
+ * @brief Implementação da codificação dos quadros do canal de comandos
+ * binário: COBS, CRC16 e cabeçalho de comando.
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "cmdlink_frame.h"
+
+/**
+ * @brief Tabela do CRC16-CCITT processado de 4 em 4 bits. Mantém a tabela
+ * pequena para caber em flash sem perder muito em relação à versão de 8 bits.
+ *
+ */
+static const uint16_t crc16_nibble[16] = {
+    0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
+    0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF,
+};
+
+uint16_t cmdlink_crc16(const uint8_t *data, size_t len, uint16_t seed) {
+  uint16_t crc = seed;
+
+  for (size_t i = 0; i < len; i++) {
+    crc = (uint16_t)(crc << 4) ^ crc16_nibble[(crc >> 12) ^ (data[i] >> 4)];
+    crc = (uint16_t)(crc << 4) ^ crc16_nibble[(crc >> 12) ^ (data[i] & 0x0F)];
+  }
+
+  return crc;
+}
+
+size_t cmdlink_cobs_encode(const uint8_t *src, size_t len, uint8_t *dst) {
+  size_t code_idx = 0;
+  size_t out = 1;
+  uint8_t code = 1;
+
+  for (size_t i = 0; i < len; i++) {
+    if (src[i] != CMDLINK_DELIMITER) {
+      dst[out++] = src[i];
+      code++;
+    }
+
+    /* Fecha o bloco ao encontrar um zero ou ao atingir 254 bytes. */
+    if (src[i] == CMDLINK_DELIMITER || code == 0xFF) {
+      dst[code_idx] = code;
+      code = 1;
+      code_idx = out++;
+    }
+  }
+
+  dst[code_idx] = code;
+
+  return out;
+}
+
+int cmdlink_cobs_decode(const uint8_t *src, size_t len, uint8_t *dst) {
+  size_t in = 0;
+  size_t out = 0;
+
+  while (in < len) {
+    uint8_t code = src[in++];
+
+    if (code == CMDLINK_DELIMITER || in + code - 1 > len) {
+      return -1;
+    }
+
+    for (uint8_t i = 1; i < code; i++) {
+      dst[out++] = src[in++];
+    }
+
+    /* Um bloco curto representa um zero, exceto o último. */
+    if (code != 0xFF && in < len) {
+      dst[out++] = CMDLINK_DELIMITER;
+    }
+  }
+
+  return (int)out;
+}
+
+size_t cmdlink_frame_encode(uint8_t *raw, size_t payload_len, uint8_t id,
+                            uint8_t seq, uint8_t *out) {
+  size_t raw_len = CMDLINK_HEADER_LEN + payload_len;
+  uint16_t crc;
+  size_t len;
+
+  if (payload_len > CMDLINK_MAX_PAYLOAD) {
+    return 0;
+  }
+
+  raw[0] = id;
+  raw[1] = seq;
+
+  /* CRC em little-endian ao fim do quadro bruto. */
+  crc = cmdlink_crc16(raw, raw_len, 0xFFFF);
+  raw[raw_len++] = (uint8_t)(crc & 0xFF);
+  raw[raw_len++] = (uint8_t)(crc >> 8);
+
+  len = cmdlink_cobs_encode(raw, raw_len, out);
+  out[len++] = CMDLINK_DELIMITER;
+
+  return len;
+}
+
+int cmdlink_frame_decode(uint8_t *buf, size_t len,
+                         struct cmdlink_frame *frame) {
+  int raw_len = cmdlink_cobs_decode(buf, len, buf);
+  uint16_t crc;
+
+  if (raw_len < CMDLINK_HEADER_LEN + CMDLINK_CRC_LEN) {
+    return -1;
+  }
+
+  raw_len -= CMDLINK_CRC_LEN;
+  crc = (uint16_t)(buf[raw_len] | (buf[raw_len + 1] << 8));
+  if (cmdlink_crc16(buf, raw_len, 0xFFFF) != crc) {
+    return -2;
+  }
+
+  frame->id = buf[0];
+  frame->seq = buf[1];
+  frame->payload.data = &buf[CMDLINK_HEADER_LEN];
+  frame->payload.len = raw_len - CMDLINK_HEADER_LEN;
+
+  return 0;
+}
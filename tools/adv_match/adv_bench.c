@@ -0,0 +1,333 @@
+/**
+ * @file adv_bench.c
+ * @brief Benchmark da verificação de advertising do Central no host. Mede
+ * relatórios por segundo e ciclos por relatório da implementação atual e da
+ * referência anterior, conferindo que ambas concordam.
+ *
+ * Uso: adv_bench [-n relatórios] [-f payloads.hex] [-s semente] [-r rodadas]
+ *
+ * As implementações são medidas alternadamente em várias rodadas, após um
+ * aquecimento, e vale a melhor rodada de cada uma; medidas únicas em
+ * sequência penalizavam a primeira (frequência da CPU e caches frios).
+ *
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define HAVE_TSC 1
+#else
+#define HAVE_TSC 0
+#endif
+
+#include "adv_reference.h"
+#include "ble_adv_match.h"
+
+/**
+ * @brief UUID do serviço BLE UART, o mesmo de ble_central.h.
+ *
+ */
+#define BENCH_UUID 0x2BC4
+
+/**
+ * @brief Tamanho máximo de um payload de advertising legado.
+ *
+ */
+#define BENCH_MAX_AD 31
+
+/**
+ * @brief Quantidade de payloads distintos no conjunto de teste.
+ *
+ */
+#define BENCH_POOL 4096
+
+/**
+ * @brief Quantidade de elementos de um vetor.
+ *
+ */
+#define ARRAY_LEN(a) (sizeof(a) / sizeof((a)[0]))
+
+typedef enum ble_adv_match_result (*match_fn)(const uint8_t *data, size_t len,
+                                             uint16_t uuid);
+
+struct payload {
+  uint8_t data[BENCH_MAX_AD];
+  uint8_t len;
+};
+
+static struct payload pool[BENCH_POOL];
+static size_t pool_len;
+
+static double now_sec(void) {
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static uint64_t cycles(void) {
+#if HAVE_TSC
+  return __rdtsc();
+#else
+  return 0;
+#endif
+}
+
+static int put_ad(struct payload *p, uint8_t type, const uint8_t *value,
+                  uint8_t len) {
+  if (p->len + 2 + len > BENCH_MAX_AD) {
+    return -1;
+  }
+
+  p->data[p->len++] = len + 1;
+  p->data[p->len++] = type;
+  memcpy(&p->data[p->len], value, len);
+  p->len += len;
+  return 0;
+}
+
+static void put_uuid16_list(struct payload *p, int count, int with_target) {
+  uint8_t list[BENCH_MAX_AD];
+  int target = with_target ? rand() % count : -1;
+
+  for (int i = 0; i < count; i++) {
+    uint16_t uuid = (i == target) ? BENCH_UUID : (0x1800 + rand() % 0x100);
+
+    list[2 * i] = uuid & 0xFF;
+    list[2 * i + 1] = uuid >> 8;
+  }
+
+  put_ad(p, rand() % 2 ? BLE_ADV_TYPE_UUID16_ALL : BLE_ADV_TYPE_UUID16_SOME,
+         list, 2 * count);
+}
+
+/**
+ * @brief Gera um payload sintético: flags, nome, dados de fabricante, UUID128,
+ * listas de UUID16 (1 em 64 com o serviço BLE UART) e estruturas malformadas.
+ *
+ */
+static void synth_payload(struct payload *p) {
+  static const uint8_t flags = 0x06;
+  uint8_t value[BENCH_MAX_AD];
+  int kind = rand() % 8;
+
+  memset(p, 0, sizeof(*p));
+  put_ad(p, 0x01, &flags, 1);
+
+  switch (kind) {
+  case 0:
+  case 1:
+    put_uuid16_list(p, 1 + rand() % 5, rand() % 64 == 0);
+    break;
+  case 2:
+    for (int i = 0; i < 8; i++) {
+      value[i] = 'a' + rand() % 26;
+    }
+    put_ad(p, 0x09, value, 4 + rand() % 5);
+    put_uuid16_list(p, 1 + rand() % 3, rand() % 64 == 0);
+    break;
+  case 3:
+  case 4:
+    for (int i = 0; i < 20; i++) {
+      value[i] = rand();
+    }
+    put_ad(p, 0xFF, value, 4 + rand() % 17);
+    break;
+  case 5:
+    for (int i = 0; i < 16; i++) {
+      value[i] = rand();
+    }
+    put_ad(p, 0x07, value, 16);
+    break;
+  case 6:
+    /* Lista de UUID16 com tamanho ímpar. */
+    value[0] = 0x0D;
+    value[1] = 0x18;
+    value[2] = 0xC4;
+    put_ad(p, BLE_ADV_TYPE_UUID16_ALL, value, 3);
+    break;
+  default:
+    /* Estrutura que ultrapassa o buffer. */
+    p->data[p->len++] = 30;
+    p->data[p->len++] = BLE_ADV_TYPE_UUID16_ALL;
+    p->data[p->len++] = 0xC4;
+    break;
+  }
+}
+
+/**
+ * @brief Carrega payloads de um arquivo, um por linha em hexadecimal. Linhas
+ * vazias ou iniciadas por '#' são ignoradas.
+ *
+ */
+static size_t load_payloads(const char *path) {
+  char line[256];
+  FILE *f = fopen(path, "r");
+  size_t count = 0;
+
+  if (f == NULL) {
+    perror(path);
+    exit(1);
+  }
+
+  while (fgets(line, sizeof(line), f) && pool_len < BENCH_POOL) {
+    struct payload *p = &pool[pool_len];
+    char *c = line;
+    unsigned byte;
+    int n;
+
+    if (line[0] == '#' || line[0] == '\n') {
+      continue;
+    }
+
+    memset(p, 0, sizeof(*p));
+    while (p->len < BENCH_MAX_AD && sscanf(c, " %2x%n", &byte, &n) == 1) {
+      p->data[p->len++] = (uint8_t)byte;
+      c += n;
+    }
+
+    pool_len++;
+    count++;
+  }
+
+  fclose(f);
+  return count;
+}
+
+/**
+ * @brief Melhor rodada de uma implementação.
+ *
+ */
+struct result {
+  const char *name; /* Nome da implementação. */
+  match_fn fn;      /* Implementação medida. */
+  double sec;       /* Menor duração. */
+  uint64_t cycles;  /* Ciclos da rodada mais rápida. */
+};
+
+static void run(struct result *r, unsigned long reports) {
+  volatile int sink = 0;
+  match_fn fn = r->fn;
+  uint64_t c0, c1;
+  double t0, t1;
+
+  t0 = now_sec();
+  c0 = cycles();
+  for (unsigned long i = 0; i < reports; i++) {
+    const struct payload *p = &pool[i % pool_len];
+
+    sink += fn(p->data, p->len, BENCH_UUID);
+  }
+  c1 = cycles();
+  t1 = now_sec();
+
+  if (r->sec == 0 || t1 - t0 < r->sec) {
+    r->sec = t1 - t0;
+    r->cycles = c1 - c0;
+  }
+  (void)sink;
+}
+
+static void report(const struct result *r, unsigned long reports) {
+  printf("%-10s %10.0f reports/s %8.1f ns/report", r->name,
+         reports / r->sec, r->sec * 1e9 / reports);
+  if (HAVE_TSC) {
+    printf(" %8.1f cycles/report", (double)r->cycles / reports);
+  }
+  printf("\n");
+}
+
+int main(int argc, char **argv) {
+  unsigned long reports = 10000000;
+  const char *payloads = NULL;
+  unsigned seed = 1;
+  int rounds = 5;
+  struct result results[] = {
+      {.name = "current", .fn = ble_adv_match_uuid16},
+      {.name = "reference", .fn = adv_reference_match},
+  };
+  size_t matches = 0, malformed = 0, from_file = 0;
+  int opt;
+
+  while ((opt = getopt(argc, argv, "n:f:s:r:")) != -1) {
+    switch (opt) {
+    case 'n':
+      reports = strtoul(optarg, NULL, 0);
+      break;
+    case 'f':
+      payloads = optarg;
+      break;
+    case 's':
+      seed = strtoul(optarg, NULL, 0);
+      break;
+    case 'r':
+      rounds = atoi(optarg) > 0 ? atoi(optarg) : 1;
+      break;
+    default:
+      fprintf(stderr,
+              "usage: %s [-n reports] [-f payloads.hex] [-s seed] "
+              "[-r rounds]\n",
+              argv[0]);
+      return 2;
+    }
+  }
+
+  srand(seed);
+  if (payloads != NULL) {
+    from_file = load_payloads(payloads);
+  }
+
+  while (pool_len < BENCH_POOL) {
+    synth_payload(&pool[pool_len++]);
+  }
+
+  /* As duas implementações precisam concordar em todo o conjunto. */
+  for (size_t i = 0; i < pool_len; i++) {
+    enum ble_adv_match_result got =
+        ble_adv_match_uuid16(pool[i].data, pool[i].len, BENCH_UUID);
+    enum ble_adv_match_result want =
+        adv_reference_match(pool[i].data, pool[i].len, BENCH_UUID);
+
+    if (got != want) {
+      fprintf(stderr, "mismatch on payload %zu: got %d, want %d\n", i, got,
+              want);
+      return 1;
+    }
+
+    matches += (got == BLE_ADV_MATCH);
+    malformed += (got == BLE_ADV_MALFORMED);
+  }
+
+  printf("pool %zu payloads (%zu from file), %zu match, %zu malformed\n",
+         pool_len, from_file, matches, malformed);
+
+  /* Aquecimento fora da medição. */
+  for (size_t i = 0; i < ARRAY_LEN(results); i++) {
+    run(&results[i], pool_len * 64);
+    results[i].sec = 0;
+  }
+
+  /* A ordem alterna a cada rodada para nenhuma implementação herdar sempre
+   * o estado deixado pela outra. */
+  for (int r = 0; r < rounds; r++) {
+    for (size_t i = 0; i < ARRAY_LEN(results); i++) {
+      run(&results[r % 2 ? ARRAY_LEN(results) - 1 - i : i], reports);
+    }
+  }
+
+  for (size_t i = 0; i < ARRAY_LEN(results); i++) {
+    report(&results[i], reports);
+  }
+
+  return 0;
+}
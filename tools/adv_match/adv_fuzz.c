@@ -0,0 +1,91 @@
+/**
+ * @file adv_fuzz.c
+ * @brief Alvo de fuzzing da verificação de advertising do Central. Os dois
+ * primeiros bytes da entrada são o UUID procurado e o restante é o payload.
+ * Compara o resultado com a implementação de referência.
+ *
+ * Com libFuzzer: make fuzz && ./adv_fuzz corpus/
+ * Sem libFuzzer: make fuzz-standalone && ./adv_fuzz_standalone [arquivos]
+ *
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "adv_reference.h"
+#include "ble_adv_match.h"
+
+int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size) {
+  uint16_t uuid;
+  uint8_t *copy;
+
+  if (size < 2 || size > 2 + 0xFFFF) {
+    return 0;
+  }
+
+  uuid = (uint16_t)(data[0] | (data[1] << 8));
+  data += 2;
+  size -= 2;
+
+  /* Cópia exata para que o ASan aponte qualquer leitura além do payload. */
+  copy = malloc(size ? size : 1);
+  memcpy(copy, data, size);
+
+  if (ble_adv_match_uuid16(copy, size, uuid) !=
+      adv_reference_match(copy, size, uuid)) {
+    fprintf(stderr, "mismatch with reference\n");
+    abort();
+  }
+
+  free(copy);
+  return 0;
+}
+
+#ifdef ADV_FUZZ_STANDALONE
+/* Executa os arquivos informados ou entradas aleatórias, sem libFuzzer. */
+int main(int argc, char **argv) {
+  uint8_t buf[2 + 64];
+
+  for (int i = 1; i < argc; i++) {
+    FILE *f = fopen(argv[i], "rb");
+    size_t n;
+
+    if (f == NULL) {
+      perror(argv[i]);
+      return 1;
+    }
+
+    n = fread(buf, 1, sizeof(buf), f);
+    fclose(f);
+    LLVMFuzzerTestOneInput(buf, n);
+  }
+
+  if (argc > 1) {
+    return 0;
+  }
+
+  srand(1);
+  for (long it = 0; it < 5000000; it++) {
+    size_t n = 2 + rand() % (sizeof(buf) - 1);
+
+    /* Tamanhos pequenos e tipos UUID16 frequentes exercitam as bordas. */
+    for (size_t j = 0; j < n; j++) {
+      int r = rand() % 8;
+
+      buf[j] = r == 0 ? 0x02 : r == 1 ? 0x03 : r < 5 ? rand() % 8 : rand();
+    }
+    buf[0] = 0xC4;
+    buf[1] = 0x2B;
+    LLVMFuzzerTestOneInput(buf, n);
+  }
+
+  printf("ok\n");
+  return 0;
+}
+#endif
@@ -0,0 +1,135 @@
+/**
+ * @file adv_reference.c
+ * @brief Referência da verificação de advertising anterior do Central.
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "adv_reference.h"
+
+#include <stdbool.h>
+#include <string.h>
+
+/* Subconjunto das estruturas do Zephyr usadas pelo código original. */
+struct net_buf_simple {
+  const uint8_t *data;
+  uint16_t len;
+};
+
+struct bt_data {
+  uint8_t type;
+  uint8_t data_len;
+  const uint8_t *data;
+};
+
+struct bt_uuid {
+  uint8_t type;
+};
+
+struct bt_uuid_16 {
+  struct bt_uuid uuid;
+  uint16_t val;
+};
+
+struct eir_ctx {
+  uint16_t uuid;
+  enum ble_adv_match_result result;
+};
+
+static uint8_t pull_u8(struct net_buf_simple *buf) {
+  uint8_t val = buf->data[0];
+
+  buf->data++;
+  buf->len--;
+  return val;
+}
+
+static int bt_uuid_cmp(const struct bt_uuid *u1, const struct bt_uuid *u2) {
+  if (u1->type != u2->type) {
+    return u1->type - u2->type;
+  }
+
+  return (int)((const struct bt_uuid_16 *)u1)->val -
+         (int)((const struct bt_uuid_16 *)u2)->val;
+}
+
+/* Cópia de bt_data_parse (subsys/bluetooth/host/adv.c). */
+static bool bt_data_parse(struct net_buf_simple *ad,
+                          bool (*func)(struct bt_data *data, void *user_data),
+                          void *user_data) {
+  bool malformed = false;
+
+  while (ad->len > 1) {
+    struct bt_data data;
+    uint8_t len;
+
+    len = pull_u8(ad);
+    if (len == 0U) {
+      break;
+    }
+
+    if (len > ad->len) {
+      malformed = true;
+      break;
+    }
+
+    data.type = pull_u8(ad);
+    data.data_len = len - 1;
+    data.data = ad->data;
+
+    if (!func(&data, user_data)) {
+      break;
+    }
+
+    ad->data += len - 1;
+    ad->len -= len - 1;
+  }
+
+  return malformed;
+}
+
+/* Lógica de ble_central_eir_found, sem as chamadas de conexão. */
+static bool eir_found(struct bt_data *data, void *user_data) {
+  struct eir_ctx *ctx = user_data;
+  struct bt_uuid_16 target = {.uuid = {0}, .val = ctx->uuid};
+
+  switch (data->type) {
+  case BLE_ADV_TYPE_UUID16_SOME:
+  case BLE_ADV_TYPE_UUID16_ALL:
+    if (data->data_len % sizeof(uint16_t) != 0U) {
+      ctx->result = BLE_ADV_MALFORMED;
+      return true;
+    }
+
+    for (int i = 0; i < data->data_len; i += sizeof(uint16_t)) {
+      struct bt_uuid_16 uuid = {.uuid = {0}};
+      uint16_t u16;
+
+      memcpy(&u16, &data->data[i], sizeof(u16));
+      uuid.val = u16; /* Host little-endian, como sys_le16_to_cpu. */
+      if (bt_uuid_cmp(&uuid.uuid, &target.uuid)) {
+        continue;
+      }
+
+      ctx->result = BLE_ADV_MATCH;
+      return false;
+    }
+  }
+
+  return true;
+}
+
+enum ble_adv_match_result adv_reference_match(const uint8_t *data, size_t len,
+                                              uint16_t uuid) {
+  struct net_buf_simple ad = {.data = data, .len = (uint16_t)len};
+  struct eir_ctx ctx = {.uuid = uuid, .result = BLE_ADV_NO_MATCH};
+
+  if (bt_data_parse(&ad, eir_found, &ctx) && ctx.result == BLE_ADV_NO_MATCH) {
+    ctx.result = BLE_ADV_MALFORMED;
+  }
+
+  return ctx.result;
+}
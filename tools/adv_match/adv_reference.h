@@ -0,0 +1,29 @@
+/**
+ * @file adv_reference.h
+ * @brief Referência da verificação de advertising anterior do Central
+ * (bt_data_parse + ble_central_eir_found), portada para o host para servir de
+ * base de comparação no benchmark e de oráculo no fuzzing.
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef ADV_REFERENCE_H_
+#define ADV_REFERENCE_H_
+
+#include "ble_adv_match.h"
+
+/**
+ * @brief Verifica os dados de advertising como a implementação anterior.
+ *
+ * @param data [in] Ponteiro para os dados de advertising.
+ * @param len Tamanho dos dados de advertising.
+ * @param uuid UUID de 16 bits procurado.
+ * @return enum ble_adv_match_result Resultado da verificação.
+ */
+enum ble_adv_match_result adv_reference_match(const uint8_t *data, size_t len,
+                                              uint16_t uuid);
+
+#endif /* ADV_REFERENCE_H_ */
@@ -0,0 +1,313 @@
+/**
+ * @file cmdlink_client.c
+ * @brief Cliente de host do canal de comandos binário. Reutiliza a
+ * codificação de quadros da biblioteca cmdlink do firmware.
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <arpa/inet.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <netdb.h>
+#include <poll.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "cmdlink_frame.h"
+
+/**
+ * @brief Quantidade máxima de comandos em voo no modo bench.
+ *
+ */
+#define CLIENT_MAX_WINDOW 256
+
+/**
+ * @brief Estado da conexão com o firmware.
+ *
+ */
+static struct {
+  int fd;                              /* Socket ou porta serial. */
+  uint8_t seq;                         /* Próxima sequência. */
+  uint8_t rx[CMDLINK_MAX_ENCODED * 4]; /* Bytes recebidos pendentes. */
+  size_t rx_len;                       /* Bytes pendentes em rx. */
+} self = {.fd = -1};
+
+static double now_sec(void) {
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static int open_socket(const char *host, const char *port) {
+  struct addrinfo hints = {.ai_family = AF_UNSPEC, .ai_socktype = SOCK_STREAM};
+  struct addrinfo *res;
+  int fd;
+
+  if (getaddrinfo(host, port, &hints, &res) != 0) {
+    return -1;
+  }
+
+  fd = socket(res->ai_family, res->ai_socktype, res->ai_protocol);
+  if (fd >= 0 && connect(fd, res->ai_addr, res->ai_addrlen) != 0) {
+    close(fd);
+    fd = -1;
+  }
+
+  freeaddrinfo(res);
+  return fd;
+}
+
+static int open_serial(const char *path, speed_t speed) {
+  struct termios tio;
+  int fd = open(path, O_RDWR | O_NOCTTY);
+
+  if (fd < 0 || tcgetattr(fd, &tio) != 0) {
+    return -1;
+  }
+
+  cfmakeraw(&tio);
+  cfsetispeed(&tio, speed);
+  cfsetospeed(&tio, speed);
+  if (tcsetattr(fd, TCSANOW, &tio) != 0) {
+    close(fd);
+    return -1;
+  }
+
+  return fd;
+}
+
+static int send_frame(uint8_t id, const uint8_t *payload, size_t len,
+                      uint8_t *seq) {
+  uint8_t raw[CMDLINK_MAX_RAW];
+  uint8_t out[CMDLINK_MAX_ENCODED];
+  size_t out_len;
+
+  memcpy(&raw[CMDLINK_HEADER_LEN], payload, len);
+  out_len = cmdlink_frame_encode(raw, len, id, self.seq, out);
+  if (out_len == 0) {
+    return -1;
+  }
+
+  *seq = self.seq++;
+  return write(self.fd, out, out_len) == (ssize_t)out_len ? 0 : -1;
+}
+
+/**
+ * @brief Lê o próximo quadro válido, esperando até timeout_ms. O payload do
+ * quadro aponta para o buffer interno e vale até a próxima chamada.
+ *
+ */
+static int recv_frame(struct cmdlink_frame *frame, int timeout_ms) {
+  static uint8_t encoded[CMDLINK_MAX_ENCODED];
+  struct pollfd pfd = {.fd = self.fd, .events = POLLIN};
+  uint8_t *end;
+  size_t len;
+  ssize_t n;
+
+  while (true) {
+    end = memchr(self.rx, CMDLINK_DELIMITER, self.rx_len);
+    if (end != NULL) {
+      len = end - self.rx;
+      if (len <= sizeof(encoded)) {
+        memcpy(encoded, self.rx, len);
+      }
+      memmove(self.rx, end + 1, self.rx_len - len - 1);
+      self.rx_len -= len + 1;
+      if (len == 0 || len > sizeof(encoded) ||
+          cmdlink_frame_decode(encoded, len, frame) != 0) {
+        fprintf(stderr, "dropped frame\n");
+        continue;
+      }
+      return 0;
+    }
+
+    if (self.rx_len == sizeof(self.rx)) {
+      self.rx_len = 0;
+    }
+
+    if (poll(&pfd, 1, timeout_ms) <= 0) {
+      return -ETIMEDOUT;
+    }
+
+    n = read(self.fd, &self.rx[self.rx_len], sizeof(self.rx) - self.rx_len);
+    if (n <= 0) {
+      return -EIO;
+    }
+    self.rx_len += n;
+  }
+}
+
+static int parse_hex(const char *hex, uint8_t *out, size_t max) {
+  size_t len = strlen(hex) / 2;
+
+  if (strlen(hex) % 2 != 0 || len > max) {
+    return -1;
+  }
+
+  for (size_t i = 0; i < len; i++) {
+    if (sscanf(&hex[2 * i], "%2hhx", &out[i]) != 1) {
+      return -1;
+    }
+  }
+
+  return (int)len;
+}
+
+static int cmd_send(uint8_t id, const char *hex) {
+  uint8_t payload[CMDLINK_MAX_PAYLOAD];
+  struct cmdlink_frame frame;
+  int len = hex ? parse_hex(hex, payload, sizeof(payload)) : 0;
+  uint8_t seq;
+
+  if (len < 0 || send_frame(id, payload, len, &seq) != 0) {
+    fprintf(stderr, "invalid payload or write failed\n");
+    return 1;
+  }
+
+  while (recv_frame(&frame, 1000) == 0) {
+    if (frame.id != (id | CMDLINK_REPLY_FLAG) || frame.seq != seq) {
+      continue;
+    }
+
+    printf("status=%u reply=", frame.payload.data[0]);
+    for (size_t i = 1; i < frame.payload.len; i++) {
+      printf("%02x", frame.payload.data[i]);
+    }
+    printf("\n");
+    return frame.payload.data[0] == CMDLINK_STATUS_OK ? 0 : 1;
+  }
+
+  fprintf(stderr, "no reply\n");
+  return 1;
+}
+
+static int cmd_bench(uint8_t id, unsigned count, unsigned window,
+                     size_t payload_len) {
+  uint8_t payload[CMDLINK_MAX_PAYLOAD] = {0};
+  double sent_at[256] = {0};
+  struct cmdlink_frame frame;
+  unsigned sent = 0, ok = 0, errors = 0, in_flight = 0;
+  double rtt_sum = 0, rtt_max = 0, start = now_sec(), elapsed;
+  uint8_t seq;
+
+  if (window == 0 || window > CLIENT_MAX_WINDOW ||
+      payload_len > sizeof(payload)) {
+    fprintf(stderr, "invalid window or payload length\n");
+    return 1;
+  }
+
+  while (ok + errors < count) {
+    while (sent < count && in_flight < window) {
+      if (send_frame(id, payload, payload_len, &seq) != 0) {
+        return 1;
+      }
+      sent_at[seq] = now_sec();
+      sent++;
+      in_flight++;
+    }
+
+    if (recv_frame(&frame, 2000) != 0) {
+      fprintf(stderr, "timeout with %u commands in flight\n", in_flight);
+      break;
+    }
+
+    if (frame.id != (id | CMDLINK_REPLY_FLAG)) {
+      continue;
+    }
+
+    double rtt = now_sec() - sent_at[frame.seq];
+
+    in_flight--;
+    if (frame.payload.data[0] != CMDLINK_STATUS_OK) {
+      errors++;
+      continue;
+    }
+
+    ok++;
+    rtt_sum += rtt;
+    rtt_max = rtt > rtt_max ? rtt : rtt_max;
+  }
+
+  elapsed = now_sec() - start;
+  printf("commands=%u ok=%u errors=%u lost=%u elapsed=%.3fs rate=%.0f cmd/s\n",
+         sent, ok, errors, sent - ok - errors, elapsed,
+         (ok + errors) / elapsed);
+  if (ok > 0) {
+    printf("rtt_us avg=%.0f max=%.0f\n", rtt_sum / ok * 1e6, rtt_max * 1e6);
+  }
+
+  return (ok == count) ? 0 : 1;
+}
+
+static void usage(const char *prog) {
+  fprintf(stderr,
+          "usage: %s [-H host] [-p port | -d tty] send <id> [hex]\n"
+          "       %s [-H host] [-p port | -d tty] bench <id> [count] "
+          "[window] [payload_len]\n",
+          prog, prog);
+}
+
+int main(int argc, char **argv) {
+  const char *host = "localhost";
+  const char *port = "1235";
+  const char *tty = NULL;
+  int opt;
+
+  while ((opt = getopt(argc, argv, "H:p:d:")) != -1) {
+    switch (opt) {
+    case 'H':
+      host = optarg;
+      break;
+    case 'p':
+      port = optarg;
+      break;
+    case 'd':
+      tty = optarg;
+      break;
+    default:
+      usage(argv[0]);
+      return 2;
+    }
+  }
+
+  if (argc - optind < 2) {
+    usage(argv[0]);
+    return 2;
+  }
+
+  self.fd = tty ? open_serial(tty, B115200) : open_socket(host, port);
+  if (self.fd < 0) {
+    perror("open");
+    return 1;
+  }
+
+  uint8_t id = (uint8_t)strtoul(argv[optind + 1], NULL, 0);
+
+  if (!strcmp(argv[optind], "send")) {
+    return cmd_send(id, argc - optind > 2 ? argv[optind + 2] : NULL);
+  }
+
+  if (!strcmp(argv[optind], "bench")) {
+    return cmd_bench(id,
+                     argc - optind > 2 ? strtoul(argv[optind + 2], NULL, 0)
+                                       : 10000,
+                     argc - optind > 3 ? strtoul(argv[optind + 3], NULL, 0)
+                                       : 16,
+                     argc - optind > 4 ? strtoul(argv[optind + 4], NULL, 0)
+                                       : 0);
+  }
+
+  usage(argv[0]);
+  return 2;
+}
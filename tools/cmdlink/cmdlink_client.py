@@ -0,0 +1,225 @@
+#!/usr/bin/env python3
+"""Host client for the cmdlink binary command channel.
+
+Frames are [id][seq][payload][crc16 le], COBS-encoded and terminated by 0x00.
+Replies carry id | 0x80 and a status byte in front of the payload.
+
+    python3 cmdlink_client.py send 1                 # ping (UartDebug)
+    python3 cmdlink_client.py send 2 68656c6c6f      # echo "hello"
+    python3 cmdlink_client.py send 1 --port 1235     # Semaphore Go
+    python3 cmdlink_client.py bench --cmd 1 --count 10000 --window 16
+    python3 cmdlink_client.py --serial /dev/ttyUSB1 bench
+"""
+
+import argparse
+import socket
+import statistics
+import sys
+import time
+
+REPLY_FLAG = 0x80
+MAX_PAYLOAD = 240
+STATUS = {0: "OK", 1: "UNKNOWN_CMD", 2: "BAD_PAYLOAD", 3: "FAILED"}
+
+
+def crc16(data, crc=0xFFFF):
+    """CRC16-CCITT, polynomial 0x1021, same as cmdlink_crc16."""
+    for byte in data:
+        crc ^= byte << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) if crc & 0x8000 else (crc << 1)
+            crc &= 0xFFFF
+    return crc
+
+
+def cobs_encode(data):
+    out = bytearray([0])
+    code_idx = 0
+    code = 1
+    for byte in data:
+        if byte:
+            out.append(byte)
+            code += 1
+        if not byte or code == 0xFF:
+            out[code_idx] = code
+            code = 1
+            code_idx = len(out)
+            out.append(0)
+    out[code_idx] = code
+    return bytes(out)
+
+
+def cobs_decode(data):
+    out = bytearray()
+    i = 0
+    while i < len(data):
+        code = data[i]
+        i += 1
+        if code == 0 or i + code - 1 > len(data):
+            raise ValueError("invalid COBS")
+        out += data[i : i + code - 1]
+        i += code - 1
+        if code != 0xFF and i < len(data):
+            out.append(0)
+    return bytes(out)
+
+
+def encode_frame(cmd_id, seq, payload=b""):
+    if len(payload) > MAX_PAYLOAD:
+        raise ValueError("payload too long")
+    raw = bytes([cmd_id, seq]) + payload
+    crc = crc16(raw)
+    return cobs_encode(raw + bytes([crc & 0xFF, crc >> 8])) + b"\x00"
+
+
+def decode_frame(encoded):
+    raw = cobs_decode(encoded)
+    if len(raw) < 4:
+        raise ValueError("short frame")
+    crc = raw[-2] | (raw[-1] << 8)
+    if crc16(raw[:-2]) != crc:
+        raise ValueError("bad CRC")
+    return raw[0], raw[1], raw[2:-2]
+
+
+class Link:
+    """Frames over a Renode socket terminal or a serial port."""
+
+    def __init__(self, args):
+        self.serial = None
+        self.sock = None
+        if args.serial:
+            import serial
+
+            self.serial = serial.Serial(args.serial, args.baudrate, timeout=0.01)
+        else:
+            self.sock = socket.create_connection((args.host, args.port))
+            self.sock.settimeout(0.01)
+        self.rx = bytearray()
+        self.seq = 0
+
+    def write(self, data):
+        if self.serial:
+            self.serial.write(data)
+        else:
+            self.sock.sendall(data)
+
+    def _read(self):
+        try:
+            if self.serial:
+                return self.serial.read(4096)
+            return self.sock.recv(4096)
+        except socket.timeout:
+            return b""
+
+    def send(self, cmd_id, payload=b""):
+        seq = self.seq
+        self.seq = (self.seq + 1) & 0xFF
+        self.write(encode_frame(cmd_id, seq, payload))
+        return seq
+
+    def frames(self):
+        """Returns every complete frame received so far."""
+        self.rx += self._read()
+        frames = []
+        while True:
+            end = self.rx.find(0)
+            if end < 0:
+                return frames
+            encoded = bytes(self.rx[:end])
+            del self.rx[: end + 1]
+            if not encoded:
+                continue
+            try:
+                frames.append(decode_frame(encoded))
+            except ValueError as err:
+                print("dropped frame: %s" % err, file=sys.stderr)
+
+    def request(self, cmd_id, payload=b"", timeout=1.0):
+        seq = self.send(cmd_id, payload)
+        deadline = time.monotonic() + timeout
+        while time.monotonic() < deadline:
+            for rid, rseq, rpayload in self.frames():
+                if rid == cmd_id | REPLY_FLAG and rseq == seq:
+                    return rpayload[0], rpayload[1:]
+        raise TimeoutError("no reply to command 0x%02x" % cmd_id)
+
+
+def cmd_send(link, args):
+    payload = bytes.fromhex(args.payload) if args.payload else b""
+    status, reply = link.request(int(args.id, 0), payload)
+    print("status=%s reply=%s" % (STATUS.get(status, status), reply.hex()))
+    return 0 if status == 0 else 1
+
+
+def cmd_bench(link, args):
+    """Keeps up to --window commands in flight and measures round trips."""
+    payload = bytes(i & 0xFF for i in range(args.payload_len))
+    in_flight = {}
+    rtts = []
+    errors = 0
+    sent = 0
+    start = time.monotonic()
+    deadline = start + args.timeout
+
+    while len(rtts) + errors < args.count and time.monotonic() < deadline:
+        while sent < args.count and len(in_flight) < args.window:
+            seq = link.send(args.cmd, payload)
+            in_flight[seq] = time.monotonic()
+            sent += 1
+        for rid, rseq, rpayload in link.frames():
+            sent_at = in_flight.pop(rseq, None)
+            if sent_at is None or rid != args.cmd | REPLY_FLAG:
+                continue
+            if rpayload[0] != 0:
+                errors += 1
+            else:
+                rtts.append(time.monotonic() - sent_at)
+
+    elapsed = time.monotonic() - start
+    done = len(rtts) + errors
+    print(
+        "commands=%d ok=%d errors=%d lost=%d elapsed=%.3fs rate=%.0f cmd/s"
+        % (sent, len(rtts), errors, sent - done, elapsed, done / elapsed)
+    )
+    if rtts:
+        rtts.sort()
+        print(
+            "rtt_us avg=%.0f p50=%.0f p99=%.0f max=%.0f"
+            % (
+                statistics.mean(rtts) * 1e6,
+                rtts[len(rtts) // 2] * 1e6,
+                rtts[int(len(rtts) * 0.99)] * 1e6,
+                rtts[-1] * 1e6,
+            )
+        )
+    return 0 if done == sent and errors == 0 else 1
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--host", default="localhost")
+    parser.add_argument("--port", type=int, default=1235)
+    parser.add_argument("--serial", help="serial device instead of a socket")
+    parser.add_argument("--baudrate", type=int, default=115200)
+    sub = parser.add_subparsers(dest="command", required=True)
+
+    send = sub.add_parser("send", help="send one command and print the reply")
+    send.add_argument("id", help="command id")
+    send.add_argument("payload", nargs="?", help="payload as hex")
+    send.set_defaults(func=cmd_send)
+
+    bench = sub.add_parser("bench", help="pipelined command throughput test")
+    bench.add_argument("--cmd", type=lambda v: int(v, 0), default=1)
+    bench.add_argument("--count", type=int, default=10000)
+    bench.add_argument("--window", type=int, default=16)
+    bench.add_argument("--payload-len", type=int, default=0)
+    bench.add_argument("--timeout", type=float, default=60.0)
+    bench.set_defaults(func=cmd_bench)
+
+    args = parser.parse_args()
+    return args.func(Link(args), args)
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,264 @@
+#!/usr/bin/env python3
+"""Renode-driven execution profiler for the repository firmwares.
+
+`run` boots a scenario with the existing Renode scripts, enables Renode's
+execution tracing (one PC per executed instruction) on every machine and runs
+it for a fixed amount of virtual time. `report` symbolizes the PC traces
+against the PlatformIO-built firmware.elf and writes, per machine:
+
+  <machine>.top.txt   top-N functions by self/total instructions and calls
+  <machine>.folded    folded call stacks (flamegraph.pl, speedscope, inferno)
+  <machine>.svg       flame graph, when flamegraph.pl is available
+
+Renode executes one instruction per virtual cycle, so instruction counts are
+the cycle cost of each function in the emulated CPU. Call stacks are rebuilt
+from the PC stream: entering a function at its first instruction is a call,
+landing inside a function already on the stack is a return.
+
+    python3 renode_profile.py run ecouart --seconds 2 --input "hello"
+    python3 renode_profile.py report ecouart --top 25
+    python3 renode_profile.py run uartdebug && python3 renode_profile.py report uartdebug
+"""
+
+import argparse
+import bisect
+import collections
+import os
+import shutil
+import subprocess
+import sys
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+ROOT = os.path.normpath(os.path.join(HERE, "..", ".."))
+
+# Renode script, machines, ELF and nm for each scenario.
+SCENARIOS = {
+    "ecouart": {
+        "script": "Ecouart/Script/ecouart.resc",
+        "input_machine": "central",
+        "machines": {
+            "central": "Ecouart/Central/.pio/build/nrf52840_dk/firmware.elf",
+            "peripheral": "Ecouart/Peripheral/.pio/build/nrf52840_dk/firmware.elf",
+        },
+        "nm": "arm-none-eabi-nm",
+    },
+    "semaphore": {
+        "script": "Semaphore/Script/semaphore.resc",
+        "input_machine": "semaphore",
+        "machines": {"semaphore": "Semaphore/.pio/build/hifive1/firmware.elf"},
+        "nm": "riscv64-unknown-elf-nm",
+    },
+    "uartdebug": {
+        "script": "UartDebug/Script/uart_bench.resc",
+        "input_machine": "uartdebug",
+        "machines": {"uartdebug": "UartDebug/.pio/build/hifive1/firmware.elf"},
+        "nm": "riscv64-unknown-elf-nm",
+    },
+}
+
+MAX_DEPTH = 64
+
+
+class Symbols:
+    """Function lookup by address from `nm -n -S` output."""
+
+    def __init__(self, nm, elf):
+        out = subprocess.check_output(
+            [nm, "-n", "-S", "--defined-only", elf], universal_newlines=True
+        )
+        self.starts = []
+        self.ends = []
+        self.names = []
+        for line in out.splitlines():
+            parts = line.split()
+            if len(parts) != 4 or parts[2] not in "tTwW":
+                continue
+            start = int(parts[0], 16) & ~1  # Thumb bit.
+            size = int(parts[1], 16)
+            if size == 0:
+                continue
+            self.starts.append(start)
+            self.ends.append(start + size)
+            self.names.append(parts[3])
+
+    def lookup(self, pc):
+        """Returns (start, end, name); outside any symbol, the gap around pc."""
+        i = bisect.bisect_right(self.starts, pc) - 1
+        if i >= 0 and pc < self.ends[i]:
+            return self.starts[i], self.ends[i], self.names[i]
+        low = self.ends[i] if i >= 0 else 0
+        high = self.starts[i + 1] if i + 1 < len(self.starts) else 1 << 64
+        return None, (low, high), "[unknown]"
+
+
+def output_dir(args):
+    return os.path.abspath(args.output or os.path.join(HERE, "out", args.scenario))
+
+
+def type_line(machine, line):
+    chars = "".join(
+        "; sysbus.uart0 WriteChar 0x%02X" % ord(c) for c in line + "\r"
+    )
+    return '; mach set "%s"%s; emulation RunFor "1"' % (machine, chars)
+
+
+def cmd_run(args):
+    scenario = SCENARIOS[args.scenario]
+    out = output_dir(args)
+    os.makedirs(out, exist_ok=True)
+
+    commands = ["include @%s" % os.path.join(ROOT, scenario["script"])]
+    for machine in scenario["machines"]:
+        commands.append('mach set "%s"' % machine)
+        commands.append(
+            'cpu CreateExecutionTracing "profile_%s" @%s PC'
+            % (machine, os.path.join(out, machine + ".pc"))
+        )
+    commands.append('emulation RunFor "%s"' % args.seconds)
+    command_line = "; ".join(commands)
+    for line in args.input:
+        command_line += type_line(scenario["input_machine"], line)
+    command_line += "; quit"
+
+    return subprocess.call(
+        [args.renode, "--disable-xwt", "--console", "-e", command_line]
+    )
+
+
+def profile(trace, symbols):
+    """Returns self counts, total counts, call counts and folded stacks.
+
+    Streaming pass: consecutive PCs inside the current function only grow a
+    run length, and the counters are charged once per run when control leaves
+    the function, so the per-instruction cost is a range check.
+    """
+    self_count = collections.Counter()
+    total_count = collections.Counter()
+    calls = collections.Counter()
+    folded = collections.Counter()
+    stack = []
+    frames = ()  # Distinct names on the stack, for total counts.
+    key = ""  # Folded form of the stack.
+    name = None  # Function owning the current run.
+    low = high = 0  # Address range of that function.
+    run = 0
+
+    with open(trace) as f:
+        for line in f:
+            if not line.startswith("0x"):
+                continue
+            pc = int(line, 16)
+            if low <= pc < high:
+                run += 1
+                continue
+
+            start, end, found = symbols.lookup(pc)
+            if start is None:
+                low, high = end
+            else:
+                low, high = start, end
+            if found == name:
+                run += 1
+                continue
+
+            if run:
+                self_count[name] += run
+                for frame in frames:
+                    total_count[frame] += run
+                folded[key] += run
+
+            if pc == start:
+                # Entry point: a call (or an interrupt) nested on the stack.
+                calls[found] += 1
+                if len(stack) < MAX_DEPTH:
+                    stack.append(found)
+                else:
+                    stack[-1] = found
+            elif found in stack:
+                # Back inside a caller: unwind to it.
+                del stack[len(stack) - 1 - stack[::-1].index(found) + 1 :]
+            elif stack:
+                # Tail call, context switch or exception return.
+                stack[-1] = found
+            else:
+                stack.append(found)
+
+            name = found
+            frames = tuple(set(stack))
+            key = ";".join(stack)
+            run = 1
+
+    if run:
+        self_count[name] += run
+        for frame in frames:
+            total_count[frame] += run
+        folded[key] += run
+
+    return self_count, total_count, calls, folded
+
+
+def cmd_report(args):
+    scenario = SCENARIOS[args.scenario]
+    out = output_dir(args)
+    flamegraph = args.flamegraph or shutil.which("flamegraph.pl")
+
+    for machine, elf in scenario["machines"].items():
+        trace = os.path.join(out, machine + ".pc")
+        if not os.path.exists(trace):
+            print("%s: no trace at %s, run first" % (machine, trace), file=sys.stderr)
+            continue
+
+        symbols = Symbols(args.nm or scenario["nm"], os.path.join(ROOT, elf))
+        self_count, total_count, calls, folded = profile(trace, symbols)
+        instructions = sum(self_count.values()) or 1
+
+        table = os.path.join(out, machine + ".top.txt")
+        with open(table, "w") as f:
+            f.write("%s: %d instructions\n" % (machine, instructions))
+            f.write("%10s %6s %10s %6s %8s  %s\n" % (
+                "self", "self%", "total", "total%", "calls", "function"))
+            for name, count in self_count.most_common(args.top):
+                f.write("%10d %5.1f%% %10d %5.1f%% %8d  %s\n" % (
+                    count, 100.0 * count / instructions,
+                    total_count[name], 100.0 * total_count[name] / instructions,
+                    calls[name], name))
+        with open(table) as f:
+            sys.stdout.write(f.read() + "\n")
+
+        folded_path = os.path.join(out, machine + ".folded")
+        with open(folded_path, "w") as f:
+            for stack, count in folded.most_common():
+                f.write("%s %d\n" % (stack, count))
+
+        if flamegraph:
+            with open(os.path.join(out, machine + ".svg"), "w") as svg:
+                subprocess.call(
+                    [flamegraph, "--title", "%s %s" % (args.scenario, machine),
+                     "--countname", "instructions", folded_path],
+                    stdout=svg,
+                )
+        else:
+            print("flamegraph.pl not found; open %s in speedscope" % folded_path)
+
+    return 0
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("mode", choices=("run", "report"))
+    parser.add_argument("scenario", choices=sorted(SCENARIOS))
+    parser.add_argument("-o", "--output", help="trace/report directory")
+    parser.add_argument("--seconds", default="2", help="virtual time to run")
+    parser.add_argument("--input", action="append", default=[],
+                        help="console line typed after the run, repeatable")
+    parser.add_argument("--renode", default="renode")
+    parser.add_argument("--nm", help="override the scenario's nm binary")
+    parser.add_argument("--top", type=int, default=20)
+    parser.add_argument("--flamegraph", help="path to flamegraph.pl")
+    args = parser.parse_args()
+
+    return cmd_run(args) if args.mode == "run" else cmd_report(args)
+
+
+if __name__ == "__main__":
+    sys.exit(main())